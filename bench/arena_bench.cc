@@ -0,0 +1,59 @@
+/*
+ * short-lived graph benchmark: builds, searches and destroys many small graphs on the global
+ * heap and on a monotonic arena that is reset after every graph
+ *
+ * usage: arena_bench [graphs] [vertices] [edges]
+ */
+
+#include <plexum/graph.h>
+
+#include "bench.h"
+
+template<template<class> class Storage>
+std::size_t build(plexum::memory_resource* r, std::size_t n, std::size_t m, unsigned seed)
+{
+	plexum::Graph<std::size_t, std::size_t, Storage> g(r);
+	bench::random_graph(g, n, m, seed);
+
+	std::size_t checksum = 0;
+
+	for (auto i = g.vertices.begin(); i != g.vertices.end(); ++i)
+		checksum += i.degree();
+
+	return checksum;
+}
+
+template<template<class> class Storage>
+void run(const std::string& name, std::size_t k, std::size_t n, std::size_t m)
+{
+	std::size_t checksum = 0;
+	bench::timer t;
+
+	for (std::size_t i = 0; i < k; i++)
+		checksum += build<Storage>(plexum::new_delete_resource(), n, m, static_cast<unsigned>(i));
+
+	bench::report(name + " heap", k, t.seconds());
+
+	plexum::monotonic_arena arena;
+	t.reset();
+
+	for (std::size_t i = 0; i < k; i++) {
+		checksum += build<Storage>(&arena, n, m, static_cast<unsigned>(i));
+		arena.reset();
+	}
+
+	bench::report(name + " arena", k, t.seconds());
+	std::cout << "checksum " << checksum << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+	std::size_t k = bench::arg(argc, argv, 1, 10000);
+	std::size_t n = bench::arg(argc, argv, 2, 64);
+	std::size_t m = bench::arg(argc, argv, 3, 256);
+
+	run<plexum::map_storage>("map_storage", k, n, m);
+	run<plexum::slot_storage>("slot_storage", k, n, m);
+
+	return 0;
+}
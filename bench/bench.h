@@ -0,0 +1,96 @@
+/*
+ * plexum graph library
+ *
+ * oliver dot michel at colorado dot edu
+ *
+ * MIT License
+ */
+
+#ifndef PLEXUM_BENCH_H
+#define PLEXUM_BENCH_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace bench
+{
+	/*! @brief measures wall clock time since construction or the last reset() */
+	class timer
+	{
+	public:
+
+		timer()
+			: _start(std::chrono::steady_clock::now())
+		{ }
+
+		void reset()
+		{
+			_start = std::chrono::steady_clock::now();
+		}
+
+		double seconds() const
+		{
+			return std::chrono::duration<double>(std::chrono::steady_clock::now() - _start).count();
+		}
+
+	private:
+		std::chrono::steady_clock::time_point _start;
+	};
+
+	/*! @brief reads a size parameter from argv[i], falling back to *def* */
+	inline std::size_t arg(int argc, char** argv, int i, std::size_t def)
+	{
+		return argc > i ? std::strtoull(argv[i], nullptr, 10) : def;
+	}
+
+	/*! @brief prints a single result line */
+	inline void report(const std::string& name, std::size_t ops, double seconds)
+	{
+		std::cout << std::left << std::setw(40) << name
+			<< std::right << std::setw(12) << ops << " ops "
+			<< std::setw(12) << std::fixed << std::setprecision(4) << seconds << " s "
+			<< std::setw(14) << std::setprecision(1) << (ops / seconds) << " ops/s" << std::endl;
+	}
+
+	/*! @brief prints a single result line for processing *bytes* bytes */
+	inline void report_bytes(const std::string& name, std::size_t bytes, double seconds)
+	{
+		std::cout << std::left << std::setw(40) << name
+			<< std::right << std::setw(12) << bytes << " B   "
+			<< std::setw(12) << std::fixed << std::setprecision(4) << seconds << " s "
+			<< std::setw(14) << std::setprecision(1) << (bytes / seconds / 1e6) << " MB/s" << std::endl;
+	}
+
+	/*! @brief returns the *p*-th percentile (0 <= p <= 1) of *samples* */
+	inline double percentile(std::vector<double> samples, double p)
+	{
+		if (samples.empty())
+			return 0;
+
+		std::sort(samples.begin(), samples.end());
+		return samples[static_cast<std::size_t>(p * (samples.size() - 1))];
+	}
+
+	/*! @brief adds *n* vertices and *m* uniformly random edges to *g* */
+	template<class G>
+	void random_graph(G& g, std::size_t n, std::size_t m, unsigned seed = 42)
+	{
+		std::mt19937_64 rng(seed);
+		std::uniform_int_distribution<std::size_t> pick(0, n - 1);
+		std::vector<typename G::vertex_proxy::iterator> v;
+
+		for (std::size_t i = 0; i < n; i++)
+			v.push_back(g.vertices.add(i));
+
+		for (std::size_t i = 0; i < m; i++)
+			g.edges.add(v[pick(rng)], v[pick(rng)], i);
+	}
+}
+
+#endif
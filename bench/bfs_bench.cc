@@ -0,0 +1,56 @@
+/*
+ * csr_graph::bfs() thread scaling benchmark, compared to a sequential top-down search
+ *
+ * usage: bfs_bench [vertices] [edges] [roots] [max threads]
+ */
+
+#include <plexum/graph.h>
+
+#include "bench.h"
+
+typedef plexum::Graph<std::size_t, std::size_t> graph;
+
+int main(int argc, char** argv)
+{
+	std::size_t n = bench::arg(argc, argv, 1, 1000000);
+	std::size_t m = bench::arg(argc, argv, 2, 16000000);
+	std::size_t k = bench::arg(argc, argv, 3, 8);
+	unsigned max_threads = static_cast<unsigned>(bench::arg(argc, argv, 4, plexum::hardware_threads()));
+
+	graph g;
+	bench::random_graph(g, n, m);
+
+	auto s = g.freeze();
+	auto all = [](const std::size_t*) { return true; };
+
+	std::mt19937_64 rng(5);
+	std::uniform_int_distribution<std::size_t> pick(0, s.vertex_count() - 1);
+	std::vector<std::size_t> roots;
+
+	for (std::size_t i = 0; i < k; i++)
+		roots.push_back(pick(rng));
+
+	std::size_t checksum = 0;
+	bench::timer t;
+
+	for (std::size_t r : roots) {
+		auto d = s.hop_distances(std::vector<std::size_t>(1, r), all, 1);
+		checksum += std::count_if(d.distance.begin(), d.distance.end(),
+								  [](double x) { return !std::isinf(x); });
+	}
+
+	bench::report("sequential top-down (traversed edges)", k * s.adjacency().size(), t.seconds());
+
+	for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+		t.reset();
+
+		for (std::size_t r : roots)
+			checksum += s.bfs(r, threads).reached;
+
+		bench::report("bfs (" + std::to_string(threads) + " threads, traversed edges)",
+					  k * s.adjacency().size(), t.seconds());
+	}
+
+	std::cout << "checksum " << checksum << std::endl;
+	return 0;
+}
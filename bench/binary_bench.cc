@@ -0,0 +1,64 @@
+/*
+ * csr_graph::save() / csr_graph::open() vs. rebuilding a snapshot benchmark
+ *
+ * usage: binary_bench [vertices] [edges] [file]
+ */
+
+#include <cstdio>
+
+#include <plexum/graph.h>
+
+#include "bench.h"
+
+typedef plexum::Graph<std::size_t, std::size_t> graph;
+typedef plexum::csr_graph<std::size_t, std::size_t> snapshot;
+
+int main(int argc, char** argv)
+{
+	std::size_t n = bench::arg(argc, argv, 1, 1000000);
+	std::size_t m = bench::arg(argc, argv, 2, 8000000);
+	std::string path = argc > 3 ? argv[3] : "binary_bench.bin";
+	std::size_t checksum = 0;
+
+	bench::timer t;
+	graph g;
+	bench::random_graph(g, n, m);
+	auto s = g.freeze();
+
+	bench::report("build graph + freeze", n + m, t.seconds());
+	t.reset();
+
+	s.save(path);
+
+	bench::report("save", n + m, t.seconds());
+	t.reset();
+
+	auto o = snapshot::open(path);
+
+	bench::report("open", n + m, t.seconds());
+	t.reset();
+
+	for (std::size_t v = 0; v < o.vertex_count(); v++)
+		for (std::size_t e : o.edges(v))
+			checksum += o.edge(e);
+
+	bench::report("first incident edge scan (opened)", 2 * m, t.seconds());
+	t.reset();
+
+	for (std::size_t v = 0; v < o.vertex_count(); v++)
+		for (std::size_t e : o.edges(v))
+			checksum += o.edge(e);
+
+	bench::report("incident edge scan (opened)", 2 * m, t.seconds());
+	t.reset();
+
+	for (std::size_t v = 0; v < s.vertex_count(); v++)
+		for (std::size_t e : s.edges(v))
+			checksum += s.edge(e);
+
+	bench::report("incident edge scan (frozen)", 2 * m, t.seconds());
+
+	std::remove(path.c_str());
+	std::cout << "checksum " << checksum << std::endl;
+	return 0;
+}
@@ -0,0 +1,69 @@
+/*
+ * incremental vs. bulk graph construction benchmark
+ *
+ * usage: bulk_load_bench [vertices] [edges] [max threads]
+ */
+
+#include <tuple>
+
+#include <plexum/graph.h>
+
+#include "bench.h"
+
+template<template<class> class Storage>
+void run(const std::string& name, std::size_t n, std::size_t m, unsigned max_threads)
+{
+	typedef plexum::Graph<std::size_t, std::size_t, Storage> graph;
+
+	std::mt19937_64 rng(42);
+	std::uniform_int_distribution<std::size_t> pick(0, n - 1);
+	std::vector<std::size_t> values(n);
+	std::vector<std::pair<std::size_t, std::size_t>> pairs;
+
+	for (std::size_t i = 0; i < n; i++)
+		values[i] = i;
+
+	for (std::size_t i = 0; i < m; i++)
+		pairs.push_back(std::make_pair(pick(rng), pick(rng)));
+
+	{
+		graph g;
+		std::vector<typename graph::vertex_proxy::iterator> v;
+		bench::timer t;
+
+		for (std::size_t i = 0; i < n; i++)
+			v.push_back(g.vertices.add(values[i]));
+
+		for (std::size_t i = 0; i < m; i++)
+			g.edges.add(v[pairs[i].first], v[pairs[i].second], i);
+
+		bench::report(name + " incremental", n + m, t.seconds());
+	}
+
+	for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+		graph g;
+		bench::timer t;
+		std::vector<std::size_t> ids = g.vertices.add_range(values.begin(), values.end());
+		std::vector<std::tuple<std::size_t, std::size_t, std::size_t>> links;
+		links.reserve(m);
+
+		for (std::size_t i = 0; i < m; i++)
+			links.push_back(std::make_tuple(ids[pairs[i].first], ids[pairs[i].second], i));
+
+		g.edges.add_range(links.begin(), links.end(), threads);
+		bench::report(name + " add_range (" + std::to_string(threads) + " threads)", n + m,
+					  t.seconds());
+	}
+}
+
+int main(int argc, char** argv)
+{
+	std::size_t n = bench::arg(argc, argv, 1, 1000000);
+	std::size_t m = bench::arg(argc, argv, 2, 10000000);
+	unsigned max_threads = static_cast<unsigned>(bench::arg(argc, argv, 3, plexum::hardware_threads()));
+
+	run<plexum::map_storage>("map_storage", n, m, max_threads);
+	run<plexum::slot_storage>("slot_storage", n, m, max_threads);
+
+	return 0;
+}
@@ -0,0 +1,81 @@
+/*
+ * edge churn benchmark: links between high-degree aggregation vertices and their leaves go
+ * down and come back up in random order, then the vertices are decommissioned
+ *
+ * usage: churn_bench [hubs] [leaves per hub] [events]
+ */
+
+#include <plexum/graph.h>
+
+#include "bench.h"
+
+template<template<class> class Storage>
+void run(const std::string& name, std::size_t hubs, std::size_t leaves, std::size_t events)
+{
+	typedef plexum::Graph<std::size_t, std::size_t, Storage> graph;
+
+	graph g;
+	std::vector<typename graph::vertex_proxy::iterator> h, l;
+	std::vector<typename graph::edge_proxy::iterator> links;
+	std::vector<std::pair<std::size_t, std::size_t>> endpoints;
+
+	for (std::size_t i = 0; i < hubs; i++)
+		h.push_back(g.vertices.add(i));
+
+	for (std::size_t i = 0; i < hubs * leaves; i++)
+		l.push_back(g.vertices.add(hubs + i));
+
+	// every leaf is dual-homed to two hubs, and the hubs form a full mesh
+	for (std::size_t i = 0; i < hubs * leaves; i++) {
+		endpoints.push_back(std::make_pair(i / leaves, hubs + i));
+		endpoints.push_back(std::make_pair((i / leaves + 1) % hubs, hubs + i));
+	}
+
+	for (std::size_t i = 0; i < hubs; i++)
+		for (std::size_t j = i + 1; j < hubs; j++)
+			endpoints.push_back(std::make_pair(i, j));
+
+	auto vertex = [&](std::size_t v) { return v < hubs ? h[v] : l[v - hubs]; };
+
+	for (std::size_t i = 0; i < endpoints.size(); i++)
+		links.push_back(g.edges.add(vertex(endpoints[i].first), vertex(endpoints[i].second), i));
+
+	std::mt19937_64 rng(13);
+	std::uniform_int_distribution<std::size_t> pick(0, links.size() - 1);
+	bench::timer t;
+
+	for (std::size_t e = 0; e < events; e++) {
+		std::size_t i = pick(rng);
+		g.edges.remove(links[i]);
+		links[i] = g.edges.add(vertex(endpoints[i].first), vertex(endpoints[i].second), i);
+	}
+
+	bench::report(name + " link down/up", events, t.seconds());
+	std::cout << "hub degree " << h[0].degree() << std::endl;
+
+	// decommission the leaves of the first hub in one batch, then the hubs one at a time
+	std::vector<typename graph::vertex_proxy::iterator> batch(l.begin(), l.begin() + leaves);
+	t.reset();
+	g.vertices.remove_with_edges(batch);
+	bench::report(name + " batch leaf removal", leaves, t.seconds());
+
+	t.reset();
+
+	for (auto& v : h)
+		g.vertices.remove_with_edges(v);
+
+	bench::report(name + " hub removal", hubs, t.seconds());
+	std::cout << "remaining edges " << g.edges.count() << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+	std::size_t hubs = bench::arg(argc, argv, 1, 16);
+	std::size_t leaves = bench::arg(argc, argv, 2, 20000);
+	std::size_t events = bench::arg(argc, argv, 3, 1000000);
+
+	run<plexum::map_storage>("map_storage", hubs, leaves, events);
+	run<plexum::slot_storage>("slot_storage", hubs, leaves, events);
+
+	return 0;
+}
@@ -0,0 +1,96 @@
+/*
+ * find_path() throughput of reader threads on published snapshots under a concurrent stream
+ * of edge updates benchmark
+ *
+ * usage: concurrent_read_bench [vertices] [edges] [max readers] [updates per publish]
+ */
+
+#include <atomic>
+#include <thread>
+
+#include <plexum/concurrent_graph.h>
+
+#include "bench.h"
+
+typedef plexum::concurrent_graph<std::size_t, std::size_t, plexum::slot_storage> concurrent;
+
+int main(int argc, char** argv)
+{
+	std::size_t n = bench::arg(argc, argv, 1, 100000);
+	std::size_t m = bench::arg(argc, argv, 2, 500000);
+	std::size_t max_readers = bench::arg(argc, argv, 3, plexum::hardware_threads());
+	std::size_t batch = bench::arg(argc, argv, 4, 1000);
+
+	std::mt19937_64 rng(42);
+	std::uniform_int_distribution<std::size_t> pick(0, n - 1);
+	concurrent c;
+	auto& g = c.writer();
+	std::vector<concurrent::graph_type::vertex_proxy::iterator> v;
+	std::vector<concurrent::graph_type::edge_proxy::iterator> e;
+
+	for (std::size_t i = 0; i < n; i++)
+		v.push_back(g.vertices.add(i));
+
+	for (std::size_t i = 0; i < m; i++)
+		e.push_back(g.edges.add(v[pick(rng)], v[pick(rng)], i));
+
+	bench::timer t;
+	c.publish();
+	bench::report("publish", n + m, t.seconds());
+
+	for (std::size_t readers = 1; readers <= max_readers; readers *= 2) {
+		std::atomic<bool> done(false);
+		std::atomic<std::size_t> queries(0);
+		std::vector<std::thread> threads;
+
+		for (std::size_t r = 0; r < readers; r++) {
+			threads.emplace_back([&c, &done, &queries, n, r] {
+				concurrent::snapshot_type::search_workspace ws;
+				std::mt19937_64 rng(r);
+				std::uniform_int_distribution<std::size_t> pick(0, n - 1);
+				std::size_t count = 0;
+
+				while (!done) {
+					auto s = c.snapshot();
+
+					try {
+						s->find_path(pick(rng), pick(rng), [](const std::size_t*) { return true; },
+									 ws);
+					} catch (const plexum::exception&) { }
+
+					count++;
+				}
+
+				queries += count;
+			});
+		}
+
+		// the writer replaces random edges and publishes after every batch of updates
+		std::size_t updates = 0;
+		std::size_t published = 0;
+		t.reset();
+
+		while (t.seconds() < 2) {
+			for (std::size_t i = 0; i < batch; i++, updates++) {
+				std::size_t k = pick(rng) % m;
+				g.edges.remove(e[k]);
+				e[k] = g.edges.add(v[pick(rng)], v[pick(rng)], k);
+			}
+
+			published += c.publish();
+		}
+
+		done = true;
+
+		for (auto& th : threads)
+			th.join();
+
+		double seconds = t.seconds();
+
+		bench::report("find_path, " + std::to_string(readers) + " readers", queries, seconds);
+		bench::report("  concurrent updates", updates, seconds);
+		bench::report("  concurrent publishes", published, seconds);
+	}
+
+	return 0;
+}
@@ -0,0 +1,81 @@
+/*
+ * connected() vs. failing find_path() on a graph with two large components benchmark
+ *
+ * usage: connectivity_bench [vertices] [edges] [queries]
+ */
+
+#include <plexum/graph.h>
+
+#include "bench.h"
+
+typedef plexum::Graph<std::size_t, std::size_t, plexum::slot_storage> graph;
+
+int main(int argc, char** argv)
+{
+	std::size_t n = bench::arg(argc, argv, 1, 200000);
+	std::size_t m = bench::arg(argc, argv, 2, 1000000);
+	std::size_t q = bench::arg(argc, argv, 3, 20);
+
+	std::mt19937_64 rng(42);
+	std::uniform_int_distribution<std::size_t> pick(0, n / 2 - 1);
+	graph g;
+	std::vector<graph::vertex_proxy::iterator> v;
+
+	for (std::size_t i = 0; i < n; i++)
+		v.push_back(g.vertices.add(i));
+
+	// the even and the odd vertices form two components
+	for (std::size_t i = 0; i < m; i++) {
+		std::size_t parity = i % 2;
+		g.edges.add(v[2 * pick(rng) + parity], v[2 * pick(rng) + parity], i);
+	}
+
+	std::vector<std::pair<std::size_t, std::size_t>> queries;
+
+	for (std::size_t i = 0; i < q; i++)
+		queries.push_back(std::make_pair(2 * pick(rng), 2 * pick(rng) + 1));
+
+	std::size_t failed = 0;
+	bench::timer t;
+
+	for (auto& p : queries) {
+		try {
+			g.find_path(v[p.first], v[p.second]);
+		} catch (const plexum::exception&) {
+			failed++;
+		}
+	}
+
+	bench::report("failing find_path (no index)", q, t.seconds());
+	t.reset();
+
+	g.component_count();
+
+	bench::report("build connectivity index", n + m, t.seconds());
+	t.reset();
+
+	for (std::size_t r = 0; r < 100000; r++)
+		failed += !g.connected(v[queries[r % q].first], v[queries[r % q].second]);
+
+	bench::report("connected()", 100000, t.seconds());
+	t.reset();
+
+	for (auto& p : queries) {
+		try {
+			g.find_path(v[p.first], v[p.second]);
+		} catch (const plexum::exception&) {
+			failed++;
+		}
+	}
+
+	bench::report("failing find_path (index)", q, t.seconds());
+	t.reset();
+
+	for (std::size_t i = 0; i < m / 10; i++)
+		g.edges.add(v[2 * pick(rng)], v[2 * pick(rng)], i);
+
+	bench::report("edges.add (index maintained)", m / 10, t.seconds());
+
+	std::cout << "failed " << failed << std::endl;
+	return 0;
+}
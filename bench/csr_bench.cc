@@ -0,0 +1,76 @@
+/*
+ * Graph::freeze() construction and csr_graph traversal benchmark
+ *
+ * usage: csr_bench [vertices] [edges] [queries] [max threads]
+ */
+
+#include <plexum/graph.h>
+
+#include "bench.h"
+
+typedef plexum::Graph<std::size_t, std::size_t> graph;
+
+int main(int argc, char** argv)
+{
+	std::size_t n = bench::arg(argc, argv, 1, 1000000);
+	std::size_t m = bench::arg(argc, argv, 2, 8000000);
+	std::size_t q = bench::arg(argc, argv, 3, 100);
+	unsigned max_threads = static_cast<unsigned>(bench::arg(argc, argv, 4, plexum::hardware_threads()));
+
+	graph g;
+	bench::random_graph(g, n, m);
+
+	for (unsigned t = 1; t <= max_threads; t *= 2) {
+		bench::timer timer;
+		auto s = g.freeze(t);
+		bench::report("freeze (" + std::to_string(t) + " threads)", s.adjacency().size(),
+					  timer.seconds());
+	}
+
+	auto s = g.freeze();
+	std::size_t checksum = 0;
+	bench::timer t;
+
+	for (auto i = g.vertices.begin(); i != g.vertices.end(); ++i)
+		for (auto& e : i.edges())
+			checksum += *e;
+
+	bench::report("incident edge scan (graph)", 2 * m, t.seconds());
+	t.reset();
+
+	for (auto i = g.vertices.begin(); i != g.vertices.end(); ++i)
+		for (std::size_t& e : i.edge_view())
+			checksum += e;
+
+	bench::report("incident edge scan (graph view)", 2 * m, t.seconds());
+	t.reset();
+
+	for (std::size_t v = 0; v < s.vertex_count(); v++)
+		for (std::size_t e : s.edges(v))
+			checksum += s.edge(e);
+
+	bench::report("incident edge scan (snapshot)", 2 * m, t.seconds());
+
+	std::mt19937_64 rng(7);
+	std::uniform_int_distribution<std::size_t> pick(0, n - 1);
+	std::vector<std::pair<std::size_t, std::size_t>> queries;
+
+	for (std::size_t i = 0; i < q; i++)
+		queries.push_back(std::make_pair(pick(rng), pick(rng)));
+
+	t.reset();
+
+	for (auto& p : queries)
+		checksum += g.find_path(g.vertices[p.first], g.vertices[p.second]).size();
+
+	bench::report("find_path (graph)", q, t.seconds());
+	t.reset();
+
+	for (auto& p : queries)
+		checksum += s.find_path(s.vertex_index(p.first), s.vertex_index(p.second)).size();
+
+	bench::report("find_path (snapshot)", q, t.seconds());
+
+	std::cout << "checksum " << checksum << std::endl;
+	return 0;
+}
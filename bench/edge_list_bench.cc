@@ -0,0 +1,83 @@
+/*
+ * plexum::read_edge_list() vs. a line-by-line loader benchmark
+ *
+ * usage: edge_list_bench [vertices] [edges] [max threads] [file]
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+#include <plexum/edge_list.h>
+
+#include "bench.h"
+
+typedef plexum::Graph<std::size_t, double, plexum::slot_storage> graph;
+
+int main(int argc, char** argv)
+{
+	std::size_t n = bench::arg(argc, argv, 1, 1000000);
+	std::size_t m = bench::arg(argc, argv, 2, 8000000);
+	unsigned max_threads = static_cast<unsigned>(bench::arg(argc, argv, 3, plexum::hardware_threads()));
+	std::string path = argc > 4 ? argv[4] : "edge_list_bench.txt";
+	std::size_t checksum = 0;
+
+	{
+		// sparse labels, as in SNAP datasets
+		std::mt19937_64 rng(42);
+		std::uniform_int_distribution<std::size_t> pick(0, n - 1);
+		std::ofstream out(path);
+
+		out << "# FromNodeId\tToNodeId\tWeight\n";
+
+		for (std::size_t i = 0; i < m; i++)
+			out << pick(rng) * 31 << '\t' << pick(rng) * 31 << '\t' << i % 100 << '\n';
+	}
+
+	std::size_t bytes = plexum::mapped_file(path).size();
+
+	{
+		bench::timer t;
+		graph g;
+		std::unordered_map<std::size_t, std::size_t> ids;
+		std::ifstream in(path);
+		std::string line;
+
+		while (std::getline(in, line)) {
+			if (line.empty() || line[0] == '#')
+				continue;
+
+			std::size_t a, b;
+			double w;
+			std::istringstream(line) >> a >> b >> w;
+
+			auto i = ids.find(a);
+			if (i == ids.end())
+				i = ids.emplace(a, g.vertices.add(a).id()).first;
+
+			auto j = ids.find(b);
+			if (j == ids.end())
+				j = ids.emplace(b, g.vertices.add(b).id()).first;
+
+			g.edges.add(g.vertices[i->second], g.vertices[j->second], w);
+		}
+
+		bench::report_bytes("line-by-line loader", bytes, t.seconds());
+		checksum += g.edges.count();
+	}
+
+	for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+		bench::timer t;
+		graph g;
+		checksum += plexum::read_edge_list(g, path, threads).size();
+
+		bench::report_bytes("read_edge_list (" + std::to_string(threads) + " threads)", bytes,
+							t.seconds());
+		checksum += g.edges.count();
+	}
+
+	std::remove(path.c_str());
+	std::cout << "checksum " << checksum << std::endl;
+	return 0;
+}
@@ -0,0 +1,62 @@
+/*
+ * edge_proxy::between() lookup benchmark
+ *
+ * usage: edge_lookup_bench [vertices] [edges] [queries]
+ */
+
+#include <plexum/graph.h>
+
+#include "bench.h"
+
+typedef plexum::Graph<std::size_t, std::size_t> graph;
+
+// reference implementation: the full edge scan between() used to perform
+graph::edge_proxy::iterator scan_between(graph& g, graph::vertex_proxy::iterator a,
+										 graph::vertex_proxy::iterator b)
+{
+	for (auto i = g.edges.begin(); i != g.edges.end(); ++i)
+		if ((i.from().id() == a.id() && i.to().id() == b.id())
+			|| (i.from().id() == b.id() && i.to().id() == a.id()))
+			return i;
+
+	return g.edges.end();
+}
+
+int main(int argc, char** argv)
+{
+	std::size_t n = bench::arg(argc, argv, 1, 100000);
+	std::size_t m = bench::arg(argc, argv, 2, 500000);
+	std::size_t q = bench::arg(argc, argv, 3, 100000);
+
+	graph g;
+	bench::random_graph(g, n, m);
+
+	std::vector<std::pair<graph::vertex_proxy::iterator, graph::vertex_proxy::iterator>> queries;
+	std::mt19937_64 rng(7);
+	std::uniform_int_distribution<std::size_t> pick(0, m - 1);
+
+	for (std::size_t i = 0; i < q; i++) {
+		auto e = g.edges[pick(rng)];
+		queries.push_back(std::make_pair(e.from(), e.to()));
+	}
+
+	std::size_t checksum = 0;
+	bench::timer t;
+
+	for (auto& p : queries)
+		checksum += g.edges.between(p.first, p.second).id();
+
+	bench::report("between (incidence list)", q, t.seconds());
+
+	// the scan is O(m) per query, so only run a small fraction of the queries
+	std::size_t q_scan = std::max<std::size_t>(1, std::min<std::size_t>(q, 2000000 / m));
+	t.reset();
+
+	for (std::size_t i = 0; i < q_scan; i++)
+		checksum += scan_between(g, queries[i].first, queries[i].second).id();
+
+	bench::report("between (edge scan)", q_scan, t.seconds());
+
+	std::cout << "checksum " << checksum << std::endl;
+	return 0;
+}
@@ -0,0 +1,74 @@
+/*
+ * sub vertex and sub edge mapping churn on a small substrate benchmark
+ *
+ * usage: embedding_bench [substrate vertices] [virtual vertices] [rounds]
+ */
+
+#include <algorithm>
+
+#include <plexum/graph.h>
+
+#include "bench.h"
+
+typedef plexum::Graph<double, double> graph;
+
+int main(int argc, char** argv)
+{
+	std::size_t n = bench::arg(argc, argv, 1, 16);
+	std::size_t k = bench::arg(argc, argv, 2, 200000);
+	std::size_t rounds = bench::arg(argc, argv, 3, 5);
+
+	std::mt19937_64 rng(42);
+	graph substrate;
+	graph virt;
+	std::vector<graph::vertex_proxy::iterator> s, v;
+	std::vector<graph::edge_proxy::iterator> se, ve;
+
+	substrate.set_demand([](double cpu) { return cpu; }, [](double bw) { return bw; });
+
+	for (std::size_t i = 0; i < n; i++)
+		s.push_back(substrate.vertices.add(1000));
+
+	for (std::size_t i = 0; i + 1 < n; i++)
+		se.push_back(substrate.edges.add(s[i], s[i + 1], 1000));
+
+	for (std::size_t i = 0; i < k; i++)
+		v.push_back(virt.vertices.add(1 + i % 4));
+
+	for (std::size_t i = 0; i + 1 < k; i++)
+		ve.push_back(virt.edges.add(v[i], v[i + 1], 1 + i % 8));
+
+	double checksum = 0;
+
+	for (std::size_t r = 0; r < rounds; r++) {
+		bench::timer t;
+
+		for (std::size_t i = 0; i < k; i++)
+			s[(i * 7 + r) % n].map(v[i]);
+
+		for (std::size_t i = 0; i + 1 < k; i++) {
+			se[(i + r) % (n - 1)].map_path(ve[i]);
+			se[(i + r + 1) % (n - 1)].map_path(ve[i]);
+		}
+
+		bench::report("map (round " + std::to_string(r) + ")", 3 * k, t.seconds());
+
+		for (std::size_t i = 0; i < n; i++)
+			checksum += s[i].load();
+
+		std::shuffle(v.begin(), v.end(), rng);
+		std::shuffle(ve.begin(), ve.end(), rng);
+		t.reset();
+
+		for (auto& x : v)
+			x.unmap_from_super_vertex();
+
+		for (auto& x : ve)
+			x.unmap_from_super_edge();
+
+		bench::report("unmap in random order", 2 * k, t.seconds());
+	}
+
+	std::cout << "checksum " << checksum << std::endl;
+	return 0;
+}
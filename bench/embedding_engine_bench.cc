@@ -0,0 +1,82 @@
+/*
+ * Graph::embed() virtual network embedding throughput benchmark
+ *
+ * usage: embedding_engine_bench [substrate vertices] [substrate edges] [requests] [active]
+ */
+
+#include <deque>
+#include <memory>
+
+#include <plexum/graph.h>
+
+#include "bench.h"
+
+typedef plexum::Graph<double, double> graph;
+
+int main(int argc, char** argv)
+{
+	std::size_t n = bench::arg(argc, argv, 1, 500);
+	std::size_t m = bench::arg(argc, argv, 2, 2000);
+	std::size_t q = bench::arg(argc, argv, 3, 10000);
+	std::size_t active = bench::arg(argc, argv, 4, 200);
+
+	std::mt19937_64 rng(42);
+	std::uniform_int_distribution<std::size_t> size(2, 10);
+	std::uniform_real_distribution<double> demand(1, 20);
+
+	graph substrate;
+	std::vector<graph::vertex_proxy::iterator> s;
+
+	for (std::size_t i = 0; i < n; i++)
+		s.push_back(substrate.vertices.add(50));
+
+	// a ring keeps the substrate connected
+	for (std::size_t i = 0; i < m; i++) {
+		std::size_t a = i < n ? i : rng() % n;
+		std::size_t b = i < n ? (i + 1) % n : rng() % n;
+		substrate.edges.add(s[a], s[b], 50);
+	}
+
+	substrate.set_demand([](double cpu) { return cpu; }, [](double bw) { return bw; });
+
+	// random connected requests: a chain plus a few chords
+	std::vector<std::unique_ptr<graph>> requests;
+
+	for (std::size_t r = 0; r < q; r++) {
+		requests.emplace_back(new graph);
+		graph& g = *requests.back();
+		std::vector<graph::vertex_proxy::iterator> v;
+		std::size_t k = size(rng);
+
+		for (std::size_t i = 0; i < k; i++)
+			v.push_back(g.vertices.add(demand(rng)));
+
+		for (std::size_t i = 0; i + 1 < k; i++)
+			g.edges.add(v[i], v[i + 1], demand(rng));
+
+		for (std::size_t i = 0; i < k / 3; i++)
+			g.edges.add(v[rng() % k], v[rng() % k], demand(rng));
+	}
+
+	auto capacity = [](double c) { return c; };
+	std::deque<graph*> embedded;
+	std::size_t accepted = 0;
+	bench::timer t;
+
+	for (auto& r : requests) {
+		if (substrate.embed(r.get(), capacity, capacity)) {
+			accepted++;
+			embedded.push_back(r.get());
+		}
+
+		// the oldest request departs once *active* are embedded
+		if (embedded.size() > active) {
+			substrate.unembed(embedded.front());
+			embedded.pop_front();
+		}
+	}
+
+	bench::report("embed + unembed", q, t.seconds());
+	std::cout << "accepted " << accepted << " of " << q << std::endl;
+	return 0;
+}
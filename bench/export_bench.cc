@@ -0,0 +1,62 @@
+/*
+ * Graph exporters vs. a plain std::ostream loop benchmark
+ *
+ * usage: export_bench [vertices] [edges] [file]
+ */
+
+#include <cstdio>
+#include <fstream>
+
+#include <plexum/graph.h>
+
+#include "bench.h"
+
+typedef plexum::Graph<std::size_t, std::size_t> graph;
+
+template<typename F>
+void run(const std::string& name, const std::string& path, F f)
+{
+	bench::timer t;
+
+	{
+		std::ofstream out(path);
+		f(out);
+	}
+
+	double seconds = t.seconds();
+	std::ifstream in(path, std::ios::binary | std::ios::ate);
+	bench::report_bytes(name, static_cast<std::size_t>(in.tellg()), seconds);
+}
+
+int main(int argc, char** argv)
+{
+	std::size_t n = bench::arg(argc, argv, 1, 1000000);
+	std::size_t m = bench::arg(argc, argv, 2, 8000000);
+	std::string path = argc > 3 ? argv[3] : "export_bench.out";
+
+	graph g;
+	bench::random_graph(g, n, m);
+
+	run("edge list (ostream, endl)", path, [&](std::ostream& os) {
+		for (auto e = g.edges.begin(); e != g.edges.end(); ++e)
+			os << e.from().id() << ' ' << e.to().id() << ' ' << *e << std::endl;
+	});
+
+	run("edge list (ostream, newline)", path, [&](std::ostream& os) {
+		for (auto e = g.edges.begin(); e != g.edges.end(); ++e)
+			os << e.from().id() << ' ' << e.to().id() << ' ' << *e << '\n';
+	});
+
+	run("write_edge_list", path, [&](std::ostream& os) { g.write_edge_list(os); });
+	run("write_dot", path, [&](std::ostream& os) { g.write_dot(os); });
+	run("write_graphml", path, [&](std::ostream& os) { g.write_graphml(os); });
+	run("operator<<", path, [&](std::ostream& os) { os << g; });
+
+	bench::timer t;
+	g.write_binary(path);
+	std::ifstream in(path, std::ios::binary | std::ios::ate);
+	bench::report_bytes("write_binary", static_cast<std::size_t>(in.tellg()), t.seconds());
+
+	std::remove(path.c_str());
+	return 0;
+}
@@ -0,0 +1,98 @@
+/*
+ * Graph::find_path() breadth-first search benchmark
+ *
+ * usage: find_path_bench [vertices] [edges] [queries]
+ */
+
+#include <list>
+#include <map>
+
+#include <plexum/graph.h>
+
+#include "bench.h"
+
+typedef plexum::Graph<std::size_t, std::size_t> graph;
+
+// reference implementation: the map-based search find_path() used to perform
+std::size_t reference_path_length(graph& g, graph::vertex_proxy::iterator s,
+								  graph::vertex_proxy::iterator t)
+{
+	std::map<unsigned long, long> visited;
+	std::list<unsigned long> queue;
+
+	for (auto i = g.vertices.begin(); i != g.vertices.end(); i++)
+		visited[i.id()] = -1;
+
+	visited[s.id()] = s.id();
+	queue.push_back(s.id());
+
+	while (!queue.empty()) {
+		unsigned long c = queue.front();
+		queue.pop_front();
+
+		if (c == t.id())
+			break;
+
+		auto c_iter = g.vertices[c];
+
+		for (auto i : c_iter.neighbors()) {
+			auto e = g.edges.between(c_iter, i);
+			if (visited[i.id()] < 0 && *e != std::size_t(-1)) {
+				visited[i.id()] = c;
+				queue.push_back(i.id());
+			}
+		}
+	}
+
+	std::size_t length = 0;
+	for (unsigned long v = t.id(); v != s.id(); v = visited[v])
+		length++;
+
+	return length;
+}
+
+int main(int argc, char** argv)
+{
+	std::size_t n = bench::arg(argc, argv, 1, 100000);
+	std::size_t m = bench::arg(argc, argv, 2, 400000);
+	std::size_t q = bench::arg(argc, argv, 3, 1000);
+
+	graph g;
+	bench::random_graph(g, n, m);
+
+	std::mt19937_64 rng(7);
+	std::uniform_int_distribution<std::size_t> pick(0, n - 1);
+	std::vector<std::pair<std::size_t, std::size_t>> queries;
+
+	for (std::size_t i = 0; i < q; i++)
+		queries.push_back(std::make_pair(pick(rng), pick(rng)));
+
+	std::size_t checksum = 0, found = 0;
+	bench::timer t;
+
+	for (auto& p : queries) {
+		try {
+			checksum += g.find_path(g.vertices[p.first], g.vertices[p.second]).size();
+			found++;
+		} catch (graph::exception&) { }
+	}
+
+	bench::report("find_path (dense workspace)", q, t.seconds());
+
+	std::size_t q_ref = std::max<std::size_t>(1, q / 200);
+	std::size_t reference = 0, expected = 0;
+	t.reset();
+
+	for (std::size_t i = 0; i < q_ref; i++)
+		reference += reference_path_length(g, g.vertices[queries[i].first],
+										   g.vertices[queries[i].second]);
+
+	bench::report("find_path (map-based reference)", q_ref, t.seconds());
+
+	for (std::size_t i = 0; i < q_ref; i++)
+		expected += g.find_path(g.vertices[queries[i].first], g.vertices[queries[i].second]).size();
+
+	std::cout << "paths " << found << "/" << q << ", checksum " << checksum
+		<< (reference == expected ? "" : " (reference mismatch)") << std::endl;
+	return 0;
+}
@@ -0,0 +1,87 @@
+/*
+ * single-threaded vs. sharded multi-threaded graph construction benchmark
+ *
+ * usage: graph_builder_bench [vertices] [edges] [max threads]
+ */
+
+#include <thread>
+
+#include <plexum/graph_builder.h>
+
+#include "bench.h"
+
+typedef plexum::Graph<std::size_t, std::size_t, plexum::slot_storage> graph;
+typedef plexum::graph_builder<std::size_t, std::size_t, plexum::slot_storage> builder;
+
+int main(int argc, char** argv)
+{
+	std::size_t n = bench::arg(argc, argv, 1, 1000000);
+	std::size_t m = bench::arg(argc, argv, 2, 5000000);
+	unsigned max_threads = static_cast<unsigned>(bench::arg(argc, argv, 3,
+															plexum::hardware_threads()));
+
+	{
+		graph g;
+		std::mt19937_64 rng(42);
+		std::uniform_int_distribution<std::size_t> pick(0, n - 1);
+		std::vector<graph::vertex_proxy::iterator> v;
+		bench::timer t;
+
+		for (std::size_t i = 0; i < n; i++)
+			v.push_back(g.vertices.add(i));
+
+		for (std::size_t i = 0; i < m; i++)
+			g.edges.add(v[pick(rng)], v[pick(rng)], i);
+
+		bench::report("single thread", n + m, t.seconds());
+	}
+
+	for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+		graph g;
+		builder b(g);
+		std::vector<std::thread> collectors;
+		std::vector<std::size_t> tickets(n);
+		bench::timer t;
+
+		// every collector records a share of the vertices, then a share of the edges between
+		// arbitrary vertices
+		std::vector<builder::shard*> shards;
+
+		for (unsigned c = 0; c < threads; c++)
+			shards.push_back(&b.make_shard());
+
+		auto collect = [&](unsigned c, bool edges) {
+			builder::shard& s = *shards[c];
+
+			if (!edges) {
+				for (std::size_t i = n * c / threads; i < n * (c + 1) / threads; i++)
+					tickets[i] = s.add_vertex(i);
+				return;
+			}
+
+			std::mt19937_64 rng(c);
+			std::uniform_int_distribution<std::size_t> pick(0, n - 1);
+
+			for (std::size_t i = m * c / threads; i < m * (c + 1) / threads; i++)
+				s.add_edge(tickets[pick(rng)], tickets[pick(rng)], i);
+		};
+
+		for (int phase = 0; phase < 2; phase++) {
+			for (unsigned c = 0; c < threads; c++)
+				collectors.emplace_back(collect, c, phase == 1);
+
+			for (auto& th : collectors)
+				th.join();
+
+			collectors.clear();
+		}
+
+		double collected = t.seconds();
+		b.commit(threads);
+
+		bench::report("sharded, " + std::to_string(threads) + " threads", n + m, t.seconds());
+		bench::report("  of which collecting", n + m, collected);
+	}
+
+	return 0;
+}
@@ -0,0 +1,67 @@
+/*
+ * Graph::k_shortest_paths() benchmark on a grid-shaped substrate
+ *
+ * usage: k_shortest_paths_bench [grid side] [queries] [k]
+ */
+
+#include <plexum/graph.h>
+
+#include "bench.h"
+
+typedef plexum::Graph<std::size_t, double> graph;
+
+int main(int argc, char** argv)
+{
+	std::size_t side = bench::arg(argc, argv, 1, 200);
+	std::size_t q = bench::arg(argc, argv, 2, 20);
+	std::size_t k = bench::arg(argc, argv, 3, 50);
+
+	graph g;
+	std::mt19937_64 rng(42);
+	std::uniform_real_distribution<double> latency(1.0, 10.0);
+	std::vector<graph::vertex_proxy::iterator> v;
+
+	for (std::size_t i = 0; i < side * side; i++)
+		v.push_back(g.vertices.add(i));
+
+	for (std::size_t r = 0; r < side; r++) {
+		for (std::size_t c = 0; c < side; c++) {
+			if (c + 1 < side)
+				g.edges.add(v[r * side + c], v[r * side + c + 1], latency(rng));
+			if (r + 1 < side)
+				g.edges.add(v[r * side + c], v[(r + 1) * side + c], latency(rng));
+		}
+	}
+
+	std::uniform_int_distribution<std::size_t> pick(0, side * side - 1);
+	std::vector<std::pair<std::size_t, std::size_t>> queries;
+
+	for (std::size_t i = 0; i < q; i++)
+		queries.push_back(std::make_pair(pick(rng), pick(rng)));
+
+	auto weight = [](double* w) { return *w; };
+	auto any = [](double*) { return true; };
+	double checksum = 0;
+
+	for (std::size_t n = 1; n <= k; n = (n == k ? k + 1 : std::min(k, n * 5))) {
+		std::vector<double> latency;
+		bench::timer total;
+
+		for (auto& p : queries) {
+			bench::timer t;
+			auto paths = g.k_shortest_paths(v[p.first], v[p.second], n, weight, any);
+
+			for (auto& path : paths)
+				checksum += path.size();
+
+			latency.push_back(t.seconds());
+		}
+
+		bench::report("k_shortest_paths (k=" + std::to_string(n) + ")", q, total.seconds());
+		std::cout << "    p50 " << bench::percentile(latency, 0.5) * 1e3 << " ms, p99 "
+			<< bench::percentile(latency, 0.99) * 1e3 << " ms" << std::endl;
+	}
+
+	std::cout << "checksum " << checksum << std::endl;
+	return 0;
+}
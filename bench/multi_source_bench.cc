@@ -0,0 +1,77 @@
+/*
+ * csr_graph multi-source distance benchmark: independent single-source searches vs. the
+ * parallel distances() / distance_rows() batch on 1..N threads
+ *
+ * usage: multi_source_bench [vertices] [edges] [sources] [max threads]
+ */
+
+#include <plexum/graph.h>
+
+#include "bench.h"
+
+typedef plexum::Graph<std::size_t, std::size_t> graph;
+
+int main(int argc, char** argv)
+{
+	std::size_t n = bench::arg(argc, argv, 1, 100000);
+	std::size_t m = bench::arg(argc, argv, 2, 800000);
+	std::size_t k = bench::arg(argc, argv, 3, 64);
+	unsigned max_threads = static_cast<unsigned>(bench::arg(argc, argv, 4, plexum::hardware_threads()));
+
+	graph g;
+	bench::random_graph(g, n, m);
+
+	auto s = g.freeze();
+	auto weight = [](const std::size_t* w) { return static_cast<double>(*w % 100 + 1); };
+	auto all = [](const std::size_t*) { return true; };
+
+	std::mt19937_64 rng(11);
+	std::uniform_int_distribution<std::size_t> pick(0, s.vertex_count() - 1);
+	std::vector<std::size_t> sources;
+
+	for (std::size_t i = 0; i < k; i++)
+		sources.push_back(pick(rng));
+
+	double checksum = 0;
+	bench::timer t;
+
+	for (std::size_t src : sources)
+		for (std::size_t dst = 0; dst < s.vertex_count(); dst += s.vertex_count() / 16 + 1)
+			if (src != dst)
+				try {
+					checksum += s.find_path(src, dst).size();
+				} catch (plexum::exception&) { }
+
+	bench::report("find_path, 16 targets per source", k, t.seconds());
+
+	for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+		t.reset();
+		auto d = s.hop_distances(sources, all, threads);
+		checksum += d.distance[d.columns];
+		bench::report("hop_distances (" + std::to_string(threads) + " threads)", k, t.seconds());
+	}
+
+	for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+		t.reset();
+		auto d = s.distances(sources, weight, all, threads);
+		checksum += d.distance[d.columns];
+		bench::report("distances (" + std::to_string(threads) + " threads)", k, t.seconds());
+	}
+
+	for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+		std::vector<double> eccentricity(k, 0);
+		t.reset();
+
+		s.distance_rows(sources, weight, all, [&](std::size_t r, const double* d, const std::size_t*) {
+			for (std::size_t v = 0; v < s.vertex_count(); v++)
+				if (d[v] > eccentricity[r] && !std::isinf(d[v]))
+					eccentricity[r] = d[v];
+		}, threads);
+
+		checksum += eccentricity[0];
+		bench::report("distance_rows (" + std::to_string(threads) + " threads)", k, t.seconds());
+	}
+
+	std::cout << "checksum " << checksum << std::endl;
+	return 0;
+}
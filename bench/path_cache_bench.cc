@@ -0,0 +1,82 @@
+/*
+ * repeated find_path() queries with and without the path cache benchmark
+ *
+ * usage: path_cache_bench [vertices] [edges] [distinct queries] [queries]
+ */
+
+#include <plexum/graph.h>
+
+#include "bench.h"
+
+typedef plexum::Graph<std::size_t, std::size_t> graph;
+
+int main(int argc, char** argv)
+{
+	std::size_t n = bench::arg(argc, argv, 1, 20000);
+	std::size_t m = bench::arg(argc, argv, 2, 100000);
+	std::size_t d = bench::arg(argc, argv, 3, 100);
+	std::size_t q = bench::arg(argc, argv, 4, 2000);
+
+	std::mt19937_64 rng(42);
+	std::uniform_int_distribution<std::size_t> pick(0, n - 1);
+	graph g;
+	std::vector<graph::vertex_proxy::iterator> v;
+	std::vector<graph::edge_proxy::iterator> e;
+
+	for (std::size_t i = 0; i < n; i++)
+		v.push_back(g.vertices.add(i));
+
+	for (std::size_t i = 0; i < m; i++)
+		e.push_back(g.edges.add(v[pick(rng)], v[pick(rng)], i));
+
+	std::vector<std::pair<std::size_t, std::size_t>> queries;
+
+	for (std::size_t i = 0; i < d; i++)
+		queries.push_back(std::make_pair(pick(rng), pick(rng)));
+
+	auto all = [](std::size_t*) { return true; };
+	std::size_t length = 0;
+	bench::timer t;
+
+	for (std::size_t i = 0; i < q; i++) {
+		auto& p = queries[i % d];
+		length += g.find_path(v[p.first], v[p.second], all).size();
+	}
+
+	bench::report("find_path (uncached)", q, t.seconds());
+
+	g.enable_path_cache(d);
+	t.reset();
+
+	for (std::size_t i = 0; i < q; i++) {
+		auto& p = queries[i % d];
+		length += g.find_path(v[p.first], v[p.second], all, plexum::path_tag(0)).size();
+	}
+
+	bench::report("find_path (cached)", q, t.seconds());
+	t.reset();
+
+	// every removal forces a check of the cached edges, and breaks the paths running over it
+	std::uniform_int_distribution<std::size_t> pick_edge(0, m - 1);
+
+	for (std::size_t i = 0; i < q; i++) {
+		if (i % 10 == 0) {
+			std::size_t r = pick_edge(rng);
+			if (e[r] != g.edges.end()) {
+				g.edges.remove(e[r]);
+				e[r] = g.edges.end();
+			}
+		}
+
+		auto& p = queries[i % d];
+		length += g.find_path(v[p.first], v[p.second], all, plexum::path_tag(0)).size();
+	}
+
+	bench::report("find_path (cached, with removals)", q, t.seconds());
+
+	plexum::path_cache_stats s = g.path_cache_statistics();
+
+	std::cout << "hits " << s.hits << ", misses " << s.misses << ", invalidations "
+			  << s.invalidations << ", length " << length << std::endl;
+	return 0;
+}
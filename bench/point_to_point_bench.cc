@@ -0,0 +1,97 @@
+/*
+ * point-to-point search strategy benchmark on a grid-shaped substrate
+ *
+ * usage: point_to_point_bench [grid side] [queries] [landmarks]
+ */
+
+#include <plexum/graph.h>
+
+#include "bench.h"
+
+typedef plexum::Graph<std::size_t, double> graph;
+
+template<typename Q>
+void run(const std::string& name, std::size_t q, graph::search_workspace& ws, Q query)
+{
+	std::vector<double> latency;
+	std::size_t expanded = 0;
+	bench::timer total;
+
+	for (std::size_t i = 0; i < q; i++) {
+		bench::timer t;
+		query(i);
+		latency.push_back(t.seconds());
+		expanded += ws.expanded();
+	}
+
+	bench::report(name, q, total.seconds());
+	std::cout << "    p50 " << bench::percentile(latency, 0.5) * 1e3 << " ms, p99 "
+		<< bench::percentile(latency, 0.99) * 1e3 << " ms, "
+		<< expanded / q << " vertices expanded per query" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+	std::size_t side = bench::arg(argc, argv, 1, 500);
+	std::size_t q = bench::arg(argc, argv, 2, 200);
+	std::size_t k = bench::arg(argc, argv, 3, 16);
+
+	graph g;
+	std::mt19937_64 rng(42);
+	std::uniform_real_distribution<double> latency(1.0, 10.0);
+	std::vector<graph::vertex_proxy::iterator> v;
+
+	for (std::size_t i = 0; i < side * side; i++)
+		v.push_back(g.vertices.add(i));
+
+	for (std::size_t r = 0; r < side; r++) {
+		for (std::size_t c = 0; c < side; c++) {
+			if (c + 1 < side)
+				g.edges.add(v[r * side + c], v[r * side + c + 1], latency(rng));
+			if (r + 1 < side)
+				g.edges.add(v[r * side + c], v[(r + 1) * side + c], latency(rng));
+		}
+	}
+
+	std::uniform_int_distribution<std::size_t> pick(0, side * side - 1);
+	std::vector<std::pair<std::size_t, std::size_t>> queries;
+
+	for (std::size_t i = 0; i < q; i++)
+		queries.push_back(std::make_pair(pick(rng), pick(rng)));
+
+	auto weight = [](double* w) { return *w; };
+	auto any = [](double*) { return true; };
+	graph::search_workspace ws;
+	double checksum = 0;
+
+	bench::timer t;
+	auto lm = g.landmarks(k, weight);
+	bench::report("landmark precomputation", k, t.seconds());
+
+	run("find_path", q, ws, [&](std::size_t i) {
+		checksum += g.find_path(v[queries[i].first], v[queries[i].second], any, ws).size();
+	});
+
+	run("find_path (bidirectional)", q, ws, [&](std::size_t i) {
+		checksum += g.find_path(v[queries[i].first], v[queries[i].second], any,
+								plexum::bidirectional_search(), ws).size();
+	});
+
+	run("shortest_path (dijkstra)", q, ws, [&](std::size_t i) {
+		checksum += g.shortest_path(v[queries[i].first], v[queries[i].second], weight, any,
+									ws).size();
+	});
+
+	run("shortest_path (bidirectional)", q, ws, [&](std::size_t i) {
+		checksum += g.shortest_path(v[queries[i].first], v[queries[i].second], weight, any,
+									plexum::bidirectional_search(), ws).size();
+	});
+
+	run("shortest_path (A*, landmarks)", q, ws, [&](std::size_t i) {
+		checksum += g.shortest_path(v[queries[i].first], v[queries[i].second], weight, any,
+									lm, ws).size();
+	});
+
+	std::cout << "checksum " << checksum << std::endl;
+	return 0;
+}
@@ -0,0 +1,59 @@
+/*
+ * Graph::shortest_path() Dijkstra benchmark
+ *
+ * usage: shortest_path_bench [vertices] [edges] [queries]
+ */
+
+#include <plexum/graph.h>
+
+#include "bench.h"
+
+typedef plexum::Graph<std::size_t, double> graph;
+
+int main(int argc, char** argv)
+{
+	std::size_t n = bench::arg(argc, argv, 1, 1000000);
+	std::size_t m = bench::arg(argc, argv, 2, 4000000);
+	std::size_t q = bench::arg(argc, argv, 3, 100);
+
+	graph g;
+	std::mt19937_64 rng(42);
+	std::uniform_int_distribution<std::size_t> pick(0, n - 1);
+	std::uniform_real_distribution<double> latency(0.1, 10.0);
+	std::vector<graph::vertex_proxy::iterator> v;
+
+	bench::timer t;
+
+	for (std::size_t i = 0; i < n; i++)
+		v.push_back(g.vertices.add(i));
+
+	for (std::size_t i = 0; i < m; i++)
+		g.edges.add(v[pick(rng)], v[pick(rng)], latency(rng));
+
+	bench::report("build", n + m, t.seconds());
+
+	std::vector<std::pair<std::size_t, std::size_t>> queries;
+
+	for (std::size_t i = 0; i < q; i++)
+		queries.push_back(std::make_pair(pick(rng), pick(rng)));
+
+	auto weight = [](double* w) { return *w; };
+	double total = 0;
+	std::size_t hops = 0;
+	t.reset();
+
+	for (auto& p : queries)
+		for (auto& e : g.shortest_path(v[p.first], v[p.second], weight))
+			total += *e;
+
+	bench::report("shortest_path (4-ary heap)", q, t.seconds());
+	t.reset();
+
+	for (auto& p : queries)
+		hops += g.find_path(v[p.first], v[p.second]).size();
+
+	bench::report("find_path (bfs, for reference)", q, t.seconds());
+
+	std::cout << "total weight " << total << ", hops " << hops << std::endl;
+	return 0;
+}
@@ -0,0 +1,81 @@
+/*
+ * map_storage vs. slot_storage iteration and lookup benchmark
+ *
+ * usage: storage_bench [vertices] [edges] [lookups]
+ */
+
+#include <plexum/graph.h>
+
+#include "bench.h"
+
+template<template<class> class Storage>
+void run(const std::string& name, std::size_t n, std::size_t m, std::size_t q)
+{
+	typedef plexum::Graph<std::size_t, std::size_t, Storage> graph;
+
+	graph g;
+	bench::timer t;
+	bench::random_graph(g, n, m);
+	bench::report(name + " build", n + m, t.seconds());
+
+	std::vector<std::size_t> ids;
+	for (auto i = g.vertices.begin(); i != g.vertices.end(); ++i)
+		ids.push_back(i.id());
+
+	std::mt19937_64 rng(7);
+	std::uniform_int_distribution<std::size_t> pick(0, ids.size() - 1);
+	std::vector<std::size_t> queries;
+
+	for (std::size_t i = 0; i < q; i++)
+		queries.push_back(ids[pick(rng)]);
+
+	std::size_t checksum = 0;
+	t.reset();
+
+	for (int r = 0; r < 10; r++)
+		for (auto i = g.vertices.begin(); i != g.vertices.end(); ++i)
+			checksum += *i;
+
+	bench::report(name + " vertex iteration", 10 * n, t.seconds());
+	t.reset();
+
+	for (int r = 0; r < 10; r++)
+		for (auto i = g.edges.begin(); i != g.edges.end(); ++i)
+			checksum += *i;
+
+	bench::report(name + " edge iteration", 10 * m, t.seconds());
+	t.reset();
+
+	for (std::size_t id : queries)
+		checksum += *g.vertices[id];
+
+	bench::report(name + " vertex lookup", q, t.seconds());
+	t.reset();
+
+	for (std::size_t id : queries)
+		checksum += g.vertices.has_index(id);
+
+	bench::report(name + " has_index", q, t.seconds());
+
+	// remove and re-add a tenth of the vertices to measure churn and slot recycling
+	t.reset();
+
+	for (std::size_t i = 0; i < n / 10; i++) {
+		auto v = g.vertices.add(i);
+		g.vertices.remove(v);
+	}
+
+	bench::report(name + " add/remove", n / 10, t.seconds());
+	std::cout << "checksum " << checksum << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+	std::size_t n = bench::arg(argc, argv, 1, 1000000);
+	std::size_t m = bench::arg(argc, argv, 2, 4000000);
+	std::size_t q = bench::arg(argc, argv, 3, 4000000);
+
+	run<plexum::map_storage>("map_storage", n, m, q);
+	run<plexum::slot_storage>("slot_storage", n, m, q);
+	return 0;
+}
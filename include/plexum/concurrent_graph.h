@@ -0,0 +1,119 @@
+/*
+ * plexum graph library
+ *
+ * oliver dot michel at colorado dot edu
+ *
+ * MIT License
+ */
+
+#ifndef PLEXUM_CONCURRENT_GRAPH_H
+#define PLEXUM_CONCURRENT_GRAPH_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+#include <plexum/csr.h>
+#include <plexum/graph.h>
+#include <plexum/memory.h>
+#include <plexum/storage.h>
+
+namespace plexum
+{
+	//
+	// plexum::concurrent_graph<VertexType, EdgeType, Storage, Direction>
+	//
+
+	/*! @brief A Graph modified by a single writer thread while any number of reader threads
+	 *         query consistent snapshots of it.
+	 *  @details The writer modifies the graph returned by writer() and calls publish() to make
+	 *           its changes visible. publish() freezes the graph into an immutable csr_graph and
+	 *           swaps it in atomically, so readers never wait for the writer and never see a
+	 *           partially applied update. A reader calls snapshot() once per unit of work and
+	 *           then runs searches, traversals and iterations on the snapshot it holds, using
+	 *           its own csr_graph::search_workspace. The snapshot stays unchanged and alive until
+	 *           the last reader holding it releases it, even if newer ones have been published
+	 *           in the meantime.
+	 *
+	 *           Every publish() takes O(n + m) time, so a writer applying a stream of updates
+	 *           should publish once per batch rather than once per update. Only the writer
+	 *           thread may call writer() and publish().
+	 *  @tparam VertexType the vertex type
+	 *  @tparam EdgeType the edge type
+	 *  @tparam Storage the storage backend of the graph, see plexum::Graph
+	 *  @tparam Direction the direction policy of the graph, see plexum::Graph
+	 */
+	template<class VertexType, class EdgeType, template<class> class Storage = map_storage,
+			 class Direction = undirected>
+	class concurrent_graph
+	{
+	public:
+
+		typedef Graph<VertexType, EdgeType, Storage, Direction> graph_type;
+		typedef csr_graph<VertexType, EdgeType> snapshot_type;
+		typedef std::shared_ptr<const snapshot_type> snapshot_ptr;
+
+		/*! @brief constructs an empty graph and publishes its empty snapshot
+		 *  @param resource the memory resource of the graph, see Graph::Graph()
+		 */
+		explicit concurrent_graph(memory_resource* resource = new_delete_resource())
+			: _graph(resource),
+			  _snapshot(std::make_shared<snapshot_type>()),
+			  _published(0)
+		{ }
+
+		concurrent_graph(const concurrent_graph&) = delete;
+		concurrent_graph& operator=(const concurrent_graph&) = delete;
+
+		/*! @brief returns the graph the writer modifies, only to be used by the writer thread */
+		inline graph_type& writer()
+		{
+			return _graph;
+		}
+
+		/*! @brief makes the current state of the graph visible to readers
+		 *  @details does nothing if no vertex or edge was added or removed since the last call
+		 *           (see Graph::version()), unless *force* is set, e.g. after changing the values
+		 *           of vertices or edges
+		 *  @param threads the number of threads used to freeze the graph, see Graph::freeze()
+		 *  @return true if a new snapshot was published
+		 */
+		bool publish(unsigned threads = 0, bool force = false)
+		{
+			std::size_t version = _graph.version();
+
+			if (!force && version == _published.load(std::memory_order_relaxed))
+				return false;
+
+			snapshot_ptr s = std::make_shared<snapshot_type>(_graph.freeze(threads));
+			std::atomic_store_explicit(&_snapshot, s, std::memory_order_release);
+			_published.store(version, std::memory_order_release);
+			return true;
+		}
+
+		/*! @brief returns the most recently published snapshot, may be called from any thread */
+		inline snapshot_ptr snapshot() const
+		{
+			return std::atomic_load_explicit(&_snapshot, std::memory_order_acquire);
+		}
+
+		/*! @brief returns the version of the graph the most recently published snapshot was
+		 *         taken at, see Graph::version()
+		 *  @details may be called from any thread; a snapshot obtained before this call may be
+		 *           older than the version returned
+		 */
+		inline std::size_t published_version() const
+		{
+			return _published.load(std::memory_order_acquire);
+		}
+
+	private:
+
+		graph_type _graph;
+
+		snapshot_ptr _snapshot;
+		std::atomic<std::size_t> _published;
+	};
+}
+
+#endif
@@ -0,0 +1,1212 @@
+/*
+ * plexum graph library
+ *
+ * oliver dot michel at colorado dot edu
+ *
+ * MIT License
+ */
+
+#ifndef PLEXUM_CSR_H
+#define PLEXUM_CSR_H
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <plexum/exception.h>
+#include <plexum/heap.h>
+#include <plexum/mapped_file.h>
+#include <plexum/parallel.h>
+
+namespace plexum
+{
+	template<class VertexType, class EdgeType, template<class> class Storage, class Direction>
+	class Graph;
+
+	//
+	// plexum::csr_graph<VertexType, EdgeType>
+	//
+
+	/*! @brief An immutable compressed sparse row (CSR) snapshot of a Graph.
+	 *  @details Vertices and edges are renumbered to dense indices in [0, vertex_count()) and
+	 *           [0, edge_count()), following the iteration order of the graph they were taken
+	 *           from. The neighbors of vertex v are adjacency()[offsets()[v] .. offsets()[v + 1]),
+	 *           and adjacency_edges() holds the index of the edge leading to each of them. Vertex
+	 *           and edge values are copied into contiguous arrays, so a snapshot stays valid when
+	 *           the originating graph is modified or destroyed. vertex_id() and edge_id() map
+	 *           dense indices back to the ids of the originating graph. Snapshots of trivially
+	 *           copyable vertex and edge types can be saved to a binary file and opened again
+	 *           through a read-only memory mapping, see save() and open().
+	 *  @tparam VertexType the vertex type
+	 *  @tparam EdgeType the edge type
+	 */
+	template<class VertexType, class EdgeType>
+	class csr_graph
+	{
+		template<class V, class E, template<class> class S, class D>
+		friend class Graph;
+
+	public:
+
+		/*! @brief the exception type thrown by snapshot operations */
+		typedef plexum::exception exception;
+
+		/*! @brief marks the absence of a vertex or edge index */
+		static const std::size_t npos = static_cast<std::size_t>(-1);
+
+		//
+		// plexum::csr_graph<VertexType, EdgeType>::range
+		//
+
+		/*! @brief a contiguous, read-only range of vertex or edge indices */
+		class range
+		{
+		public:
+
+			range(const std::size_t* first, const std::size_t* last)
+				: _first(first),
+				  _last(last)
+			{ }
+
+			inline const std::size_t* begin() const
+			{
+				return _first;
+			}
+
+			inline const std::size_t* end() const
+			{
+				return _last;
+			}
+
+			inline std::size_t size() const
+			{
+				return static_cast<std::size_t>(_last - _first);
+			}
+
+			inline std::size_t operator[](std::size_t i) const
+			{
+				return _first[i];
+			}
+
+			inline const std::size_t* data() const
+			{
+				return _first;
+			}
+
+			inline bool operator==(const range& other) const
+			{
+				return size() == other.size() && std::equal(_first, _last, other._first);
+			}
+
+			inline bool operator!=(const range& other) const
+			{
+				return !(*this == other);
+			}
+
+		private:
+			const std::size_t* _first;
+			const std::size_t* _last;
+		};
+
+		//
+		// plexum::csr_graph<VertexType, EdgeType>::search_workspace
+		//
+
+		/*! @brief Reusable scratch space for searches on a snapshot.
+		 *  @details see Graph::search_workspace
+		 */
+		class search_workspace
+		{
+			friend class csr_graph<VertexType, EdgeType>;
+
+		public:
+
+			search_workspace()
+				: _epoch(0),
+				  _visited(),
+				  _parent(),
+				  _frontier()
+			{ }
+
+		private:
+
+			void _reset(std::size_t n)
+			{
+				if (_visited.size() < n) {
+					_visited.resize(n, 0);
+					_parent.resize(n, npos);
+					_frontier.resize(n, npos);
+				}
+
+				if (++_epoch == 0) {
+					std::fill(_visited.begin(), _visited.end(), 0);
+					_epoch = 1;
+				}
+			}
+
+			std::uint32_t _epoch;
+			std::vector<std::uint32_t> _visited;
+			std::vector<std::size_t> _parent;
+			std::vector<std::size_t> _frontier;
+		};
+
+		//
+		// plexum::csr_graph<VertexType, EdgeType>::distance_matrix
+		//
+
+		/*! @brief Distances and predecessor edges from a set of sources, stored row-major.
+		 *  @details row r holds the distances from the r-th source to every vertex, infinity for
+		 *           unreachable vertices, and the index of the last edge on a shortest path to
+		 *           every vertex, npos for the source itself and unreachable vertices
+		 */
+		struct distance_matrix
+		{
+			std::size_t rows;
+			std::size_t columns;
+			std::vector<double> distance;
+			std::vector<std::size_t> predecessor;
+
+			inline double at(std::size_t row, std::size_t v) const
+			{
+				return distance[row * columns + v];
+			}
+
+			inline std::size_t predecessor_at(std::size_t row, std::size_t v) const
+			{
+				return predecessor[row * columns + v];
+			}
+		};
+
+		//
+		// plexum::csr_graph<VertexType, EdgeType>::bfs_tree
+		//
+
+		/*! @brief The breadth-first search tree of all vertices reachable from a root.
+		 *  @details level holds the number of edges between the root and every vertex, npos for
+		 *           unreachable vertices. parent_edge holds the index of the edge connecting every
+		 *           reached vertex to its parent, npos for the root and unreachable vertices.
+		 */
+		struct bfs_tree
+		{
+			std::size_t root;
+			std::size_t reached;
+			std::vector<std::size_t> level;
+			std::vector<std::size_t> parent_edge;
+
+			/*! @brief returns the parent vertex of *v* in *g* or npos if *v* has none */
+			inline std::size_t parent(const csr_graph& g, std::size_t v) const
+			{
+				std::size_t e = parent_edge[v];
+
+				if (e == npos)
+					return npos;
+
+				return g.source(e) == v ? g.target(e) : g.source(e);
+			}
+		};
+
+		/*! @brief the top-down to bottom-up switching threshold of bfs(): the search turns
+		 *         bottom-up once the frontier has more than 1/BFS_ALPHA of all unexplored edges
+		 */
+		static const std::size_t BFS_ALPHA = 14;
+
+		/*! @brief the bottom-up to top-down switching threshold of bfs(): the search turns back
+		 *         top-down once the frontier holds fewer than 1/BFS_BETA of all vertices
+		 */
+		static const std::size_t BFS_BETA = 24;
+
+		/*! @brief the version of the binary format written by save() */
+		static const std::uint32_t BINARY_VERSION = 1;
+
+		/*! @brief the byte alignment of every section of the binary format */
+		static const std::size_t SECTION_ALIGNMENT = 64;
+
+		/*! @brief constructs an empty snapshot */
+		csr_graph()
+			: _offsets(1, 0),
+			  _adjacency(),
+			  _adjacency_edges(),
+			  _source(),
+			  _target(),
+			  _vertex_ids(),
+			  _edge_ids(),
+			  _vertex_index(),
+			  _edge_index(),
+			  _index_mask(~std::size_t(0)),
+			  _directed(false),
+			  _vertices(),
+			  _edges(),
+			  _workspace(),
+			  _file()
+		{ }
+
+		/*! @brief opens a snapshot written by save() through a read-only memory mapping
+		 *  @details The arrays of the snapshot refer to the mapped file instead of being read
+		 *           into memory, so opening takes constant time regardless of the size of the
+		 *           graph, and pages are loaded by the operating system on first access. Only the
+		 *           header and the section bounds are validated, the contents are trusted. The
+		 *           mapping is released when the snapshot and all its copies are destroyed.
+		 *  @throws exception if the file cannot be mapped, was written by another version or
+		 *          platform or for other vertex and edge types, or is truncated
+		 */
+		static csr_graph open(const std::string& path)
+		{
+			static_assert(std::is_trivially_copyable<VertexType>::value
+						  && std::is_trivially_copyable<EdgeType>::value,
+						  "csr_graph::open() requires trivially copyable vertex and edge types");
+
+			csr_graph c;
+			c._file = std::make_shared<mapped_file>(path);
+
+			const char* base = c._file->data();
+			std::size_t size = c._file->size();
+			_binary_header h;
+
+			if (size < sizeof(h))
+				throw exception("csr_graph::open(): " + path + " is not a plexum graph");
+
+			std::memcpy(&h, base, sizeof(h));
+			_binary_header expected = _header();
+
+			if (std::memcmp(h.magic, expected.magic, sizeof(h.magic)) != 0)
+				throw exception("csr_graph::open(): " + path + " is not a plexum graph");
+
+			if (h.version != BINARY_VERSION)
+				throw exception("csr_graph::open(): " + path + " has unsupported version "
+								+ std::to_string(h.version));
+
+			if (h.byte_order != expected.byte_order || h.word_size != expected.word_size)
+				throw exception("csr_graph::open(): " + path + " was written on another platform");
+
+			if (h.vertex_size != expected.vertex_size || h.edge_size != expected.edge_size)
+				throw exception("csr_graph::open(): " + path + " holds other vertex or edge types");
+
+			std::size_t n = h.vertex_count, m = h.edge_count, a = h.adjacency_size;
+
+			c._index_mask = h.index_mask;
+			c._directed = h.flags & _BINARY_DIRECTED;
+			c._offsets._view(_section<std::size_t>(path, base, size, h, 0, n + 1), n + 1);
+			c._adjacency._view(_section<std::size_t>(path, base, size, h, 1, a), a);
+			c._adjacency_edges._view(_section<std::size_t>(path, base, size, h, 2, a), a);
+			c._source._view(_section<std::size_t>(path, base, size, h, 3, m), m);
+			c._target._view(_section<std::size_t>(path, base, size, h, 4, m), m);
+			c._vertex_ids._view(_section<std::size_t>(path, base, size, h, 5, n), n);
+			c._edge_ids._view(_section<std::size_t>(path, base, size, h, 6, m), m);
+			c._vertex_index._view(_section<std::size_t>(path, base, size, h, 7, h.vertex_index_size),
+								  h.vertex_index_size);
+			c._edge_index._view(_section<std::size_t>(path, base, size, h, 8, h.edge_index_size),
+								h.edge_index_size);
+			c._vertices._view(_section<VertexType>(path, base, size, h, 9, n), n);
+			c._edges._view(_section<EdgeType>(path, base, size, h, 10, m), m);
+
+			if (c._offsets[n] != a)
+				throw exception("csr_graph::open(): " + path + " is corrupt");
+
+			return c;
+		}
+
+		/*! @brief writes the snapshot to the binary file at *path*
+		 *  @details The file starts with a versioned header, followed by the offsets, the
+		 *           adjacency and edge endpoint arrays, the id mappings and the raw vertex and edge
+		 *           values, each section aligned to SECTION_ALIGNMENT bytes so it can be used in
+		 *           place when mapped. Numbers are stored in the byte order and word size of the
+		 *           writing platform. The file is written to *path*.tmp first and then renamed
+		 *           over *path*, so existing mappings of *path* stay valid.
+		 *  @throws exception if the file cannot be written
+		 */
+		void save(const std::string& path) const
+		{
+			static_assert(std::is_trivially_copyable<VertexType>::value
+						  && std::is_trivially_copyable<EdgeType>::value,
+						  "csr_graph::save() requires trivially copyable vertex and edge types");
+
+			const std::size_t counts[_BINARY_SECTIONS] = {
+				_offsets.size(), _adjacency.size(), _adjacency_edges.size(), _source.size(),
+				_target.size(), _vertex_ids.size(), _edge_ids.size(), _vertex_index.size(),
+				_edge_index.size(), _vertices.size(), _edges.size()
+			};
+			const char* data[_BINARY_SECTIONS] = {
+				_bytes(_offsets), _bytes(_adjacency), _bytes(_adjacency_edges), _bytes(_source),
+				_bytes(_target), _bytes(_vertex_ids), _bytes(_edge_ids), _bytes(_vertex_index),
+				_bytes(_edge_index), _bytes(_vertices), _bytes(_edges)
+			};
+			const std::size_t widths[_BINARY_SECTIONS] = {
+				sizeof(std::size_t), sizeof(std::size_t), sizeof(std::size_t), sizeof(std::size_t),
+				sizeof(std::size_t), sizeof(std::size_t), sizeof(std::size_t), sizeof(std::size_t),
+				sizeof(std::size_t), sizeof(VertexType), sizeof(EdgeType)
+			};
+
+			_binary_header h = _header();
+			h.flags = _directed ? _BINARY_DIRECTED : 0;
+			h.index_mask = _index_mask;
+			h.vertex_count = vertex_count();
+			h.edge_count = edge_count();
+			h.adjacency_size = _adjacency.size();
+			h.vertex_index_size = _vertex_index.size();
+			h.edge_index_size = _edge_index.size();
+
+			std::uint64_t end = _align(sizeof(h));
+
+			for (std::size_t i = 0; i < _BINARY_SECTIONS; i++) {
+				h.section[i] = end;
+				end = _align(end + counts[i] * widths[i]);
+			}
+
+			// written beside the target and renamed over it, so a snapshot mapped from *path*
+			// keeps its file until it is closed
+			std::string temporary = path + ".tmp";
+			std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+			const char padding[SECTION_ALIGNMENT] = { };
+
+			out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+			out.write(padding, h.section[0] - sizeof(h));
+
+			for (std::size_t i = 0; i < _BINARY_SECTIONS; i++) {
+				std::size_t bytes = counts[i] * widths[i];
+				out.write(data[i], bytes);
+				out.write(padding, _align(h.section[i] + bytes) - (h.section[i] + bytes));
+			}
+
+			out.close();
+
+			if (!out || std::rename(temporary.c_str(), path.c_str()) != 0) {
+				std::remove(temporary.c_str());
+				throw exception("csr_graph::save(): cannot write " + path);
+			}
+		}
+
+		inline std::size_t vertex_count() const
+		{
+			return _vertex_ids.size();
+		}
+
+		inline std::size_t edge_count() const
+		{
+			return _edge_ids.size();
+		}
+
+		/*! @brief checks whether the snapshot was taken from a directed graph, whose adjacency
+		 *         only holds the outgoing edges of every vertex
+		 */
+		inline bool directed() const
+		{
+			return _directed;
+		}
+
+		/*! @brief returns the number of adjacency entries of vertex *v* */
+		inline std::size_t degree(std::size_t v) const
+		{
+			return _offsets[v + 1] - _offsets[v];
+		}
+
+		/*! @brief returns the indices of the neighbors of vertex *v* */
+		inline range neighbors(std::size_t v) const
+		{
+			return range(_adjacency.data() + _offsets[v], _adjacency.data() + _offsets[v + 1]);
+		}
+
+		/*! @brief returns the indices of the edges incident to vertex *v*, in the same order as
+		 *         neighbors(v)
+		 */
+		inline range edges(std::size_t v) const
+		{
+			return range(_adjacency_edges.data() + _offsets[v],
+						 _adjacency_edges.data() + _offsets[v + 1]);
+		}
+
+		inline const VertexType& vertex(std::size_t v) const
+		{
+			return _vertices[v];
+		}
+
+		inline const EdgeType& edge(std::size_t e) const
+		{
+			return _edges[e];
+		}
+
+		/*! @brief returns the index of the vertex edge *e* was added from */
+		inline std::size_t source(std::size_t e) const
+		{
+			return _source[e];
+		}
+
+		/*! @brief returns the index of the vertex edge *e* was added to */
+		inline std::size_t target(std::size_t e) const
+		{
+			return _target[e];
+		}
+
+		/*! @brief returns the id vertex *v* has in the originating graph */
+		inline std::size_t vertex_id(std::size_t v) const
+		{
+			return _vertex_ids[v];
+		}
+
+		/*! @brief returns the id edge *e* has in the originating graph */
+		inline std::size_t edge_id(std::size_t e) const
+		{
+			return _edge_ids[e];
+		}
+
+		/*! @brief returns the index of the vertex with *id* in the originating graph
+		 *  @throws exception if the snapshot does not contain such a vertex
+		 */
+		std::size_t vertex_index(std::size_t id) const
+		{
+			std::size_t i = id & _index_mask;
+
+			if (i < _vertex_index.size() && _vertex_index[i] != npos
+				&& _vertex_ids[_vertex_index[i]] == id)
+				return _vertex_index[i];
+
+			throw exception("csr_graph::vertex_index(): id " + std::to_string(id)
+							+ " does not exist.");
+		}
+
+		/*! @brief returns the index of the edge with *id* in the originating graph
+		 *  @throws exception if the snapshot does not contain such an edge
+		 */
+		std::size_t edge_index(std::size_t id) const
+		{
+			std::size_t i = id & _index_mask;
+
+			if (i < _edge_index.size() && _edge_index[i] != npos && _edge_ids[_edge_index[i]] == id)
+				return _edge_index[i];
+
+			throw exception("csr_graph::edge_index(): id " + std::to_string(id)
+							+ " does not exist.");
+		}
+
+		/*! @brief the vertex_count() + 1 row offsets into adjacency() */
+		inline range offsets() const
+		{
+			return range(_offsets.begin(), _offsets.end());
+		}
+
+		/*! @brief the concatenated neighbor indices of all vertices */
+		inline range adjacency() const
+		{
+			return range(_adjacency.begin(), _adjacency.end());
+		}
+
+		/*! @brief the edge index belonging to each entry of adjacency() */
+		inline range adjacency_edges() const
+		{
+			return range(_adjacency_edges.begin(), _adjacency_edges.end());
+		}
+
+		/*! @brief finds a path with the least number of edges between vertices *start* and *target*
+		 *  @return the indices of the edges along the path, ordered from *start* to *target*
+		 *  @throws exception if there is no path between *start* and *target*
+		 */
+		std::vector<std::size_t> find_path(std::size_t start, std::size_t target)
+		{
+			return find_path(start, target, [](const EdgeType*) { return true; });
+		}
+
+		/*! @brief finds a path with the least number of edges between vertices *start* and *target*
+		 *         only using edges *e* for which *cstr(e)* holds
+		 *  @return the indices of the edges along the path, ordered from *start* to *target*
+		 *  @throws exception if *start* or *target* is not a vertex index or if there is no such
+		 *          path between them
+		 */
+		template<typename F>
+		std::vector<std::size_t> find_path(std::size_t start, std::size_t target, F cstr)
+		{
+			return find_path(start, target, cstr, _workspace);
+		}
+
+		/*! @brief same as find_path(start, target, cstr), using the caller-provided workspace *ws*
+		 *  @details a snapshot is immutable, so any number of threads may search it concurrently,
+		 *           each on its own workspace
+		 */
+		template<typename F>
+		std::vector<std::size_t> find_path(std::size_t start, std::size_t target, F cstr,
+										   search_workspace& ws) const
+		{
+			std::vector<std::size_t> path;
+
+			if (start >= vertex_count() || target >= vertex_count())
+				throw exception("csr_graph: vertex index "
+								+ std::to_string(start >= vertex_count() ? start : target)
+								+ " does not exist.");
+
+			if (!_bfs(start, target, cstr, ws))
+				throw exception("there is no path between the specified vertices");
+
+			for (std::size_t v = target; v != start; ) {
+				std::size_t e = ws._parent[v];
+				path.push_back(e);
+				v = _source[e] == v ? _target[e] : _source[e];
+			}
+
+			std::reverse(path.begin(), path.end());
+			return path;
+		}
+
+		/*! @brief computes the least total edge weights from each of *sources* to all vertices
+		 *  @details runs one Dijkstra search per source, distributed over up to *threads* threads
+		 *           (0 selects one per hardware thread), each with its own workspace
+		 *  @param weight a functor returning the non-negative weight of an edge given a const
+		 *         EdgeType*
+		 *  @param cstr a functor deciding whether an edge given as const EdgeType* may be used
+		 *  @throws exception if a negative edge weight is encountered
+		 */
+		template<typename W, typename F>
+		distance_matrix distances(const std::vector<std::size_t>& sources, W weight, F cstr,
+								  unsigned threads = 0) const
+		{
+			distance_matrix m = _matrix(sources.size());
+
+			_for_each_source(sources, threads, [&](std::size_t r, _row_workspace& ws) {
+				_dijkstra_row(sources[r], weight, cstr, &m.distance[r * m.columns],
+							  &m.predecessor[r * m.columns], ws);
+			});
+
+			return m;
+		}
+
+		/*! @brief computes the least total edge weights from each of *sources* to all vertices and
+		 *         hands each row to *row* instead of storing all of them
+		 *  @details *row* is called as row(r, distance, predecessor) with the index r into
+		 *           *sources* and two arrays of vertex_count() entries laid out like a row of a
+		 *           distance_matrix. It is called concurrently from the worker threads, and the
+		 *           arrays are only valid during the call.
+		 *  @throws exception if a negative edge weight is encountered
+		 */
+		template<typename W, typename F, typename R>
+		void distance_rows(const std::vector<std::size_t>& sources, W weight, F cstr, R row,
+						   unsigned threads = 0) const
+		{
+			_for_each_source(sources, threads, [&](std::size_t r, _row_workspace& ws) {
+				_dijkstra_row(sources[r], weight, cstr, ws.distance.data(), ws.predecessor.data(), ws);
+				row(r, static_cast<const double*>(ws.distance.data()),
+					static_cast<const std::size_t*>(ws.predecessor.data()));
+			});
+		}
+
+		/*! @brief computes the least number of edges from each of *sources* to all vertices
+		 *  @details same as distances(), running one breadth-first search per source
+		 */
+		template<typename F>
+		distance_matrix hop_distances(const std::vector<std::size_t>& sources, F cstr,
+									  unsigned threads = 0) const
+		{
+			distance_matrix m = _matrix(sources.size());
+
+			_for_each_source(sources, threads, [&](std::size_t r, _row_workspace& ws) {
+				_bfs_row(sources[r], cstr, &m.distance[r * m.columns], &m.predecessor[r * m.columns], ws);
+			});
+
+			return m;
+		}
+
+		/*! @brief computes the least number of edges from each of *sources* to all vertices and
+		 *         hands each row to *row* instead of storing all of them
+		 *  @details same as distance_rows(), running one breadth-first search per source
+		 */
+		template<typename F, typename R>
+		void hop_distance_rows(const std::vector<std::size_t>& sources, F cstr, R row,
+							   unsigned threads = 0) const
+		{
+			_for_each_source(sources, threads, [&](std::size_t r, _row_workspace& ws) {
+				_bfs_row(sources[r], cstr, ws.distance.data(), ws.predecessor.data(), ws);
+				row(r, static_cast<const double*>(ws.distance.data()),
+					static_cast<const std::size_t*>(ws.predecessor.data()));
+			});
+		}
+
+		/*! @brief computes the breadth-first search tree of all vertices reachable from *root*
+		 *  @details A direction-optimizing search on up to *threads* threads (0 selects one per
+		 *           hardware thread). While the frontier is small, each level is expanded top-down
+		 *           from a queue of frontier vertices, claiming new vertices in an atomic visited
+		 *           bitmap. Once the frontier covers a large share of the unexplored edges (see
+		 *           BFS_ALPHA and BFS_BETA), the search turns bottom-up: every unvisited vertex scans
+		 *           its neighbors for one in the frontier bitmap and stops at the first hit. Levels
+		 *           are the same for any number of threads, parents may differ. Snapshots of
+		 *           directed graphs lack the incoming edges bottom-up steps scan, so they are
+		 *           searched top-down only.
+		 *  @throws exception if *root* is not a vertex index
+		 */
+		bfs_tree bfs(std::size_t root, unsigned threads = 0) const
+		{
+			if (root >= vertex_count())
+				throw exception("csr_graph: vertex index " + std::to_string(root) + " does not exist.");
+
+			if (threads == 0)
+				threads = hardware_threads();
+
+			std::size_t n = vertex_count(), words = (n + 63) / 64;
+
+			bfs_tree tree;
+			tree.root = root;
+			tree.reached = 1;
+			tree.level.assign(n, npos);
+			tree.parent_edge.assign(n, npos);
+			tree.level[root] = 0;
+
+			_bfs_state state(words, threads);
+			state.visited[root / 64] = std::uint64_t(1) << (root % 64);
+			state.queue.push_back(root);
+
+			std::size_t frontier = 1, frontier_edges = degree(root);
+			std::size_t unexplored = _adjacency.size() - frontier_edges;
+			bool bottom_up = false;
+
+			for (std::size_t depth = 1; frontier > 0; depth++) {
+				if (!bottom_up && !_directed && frontier_edges > unexplored / BFS_ALPHA) {
+					std::fill(state.frontier.begin(), state.frontier.end(), 0);
+					for (std::size_t v : state.queue)
+						state.frontier[v / 64] |= std::uint64_t(1) << (v % 64);
+					bottom_up = true;
+				} else if (bottom_up && frontier < n / BFS_BETA) {
+					state.queue.clear();
+					for (std::size_t w = 0; w < words; w++)
+						for (std::size_t j = 0; j < 64 && state.frontier[w] >> j; j++)
+							if (state.frontier[w] >> j & 1)
+								state.queue.push_back(w * 64 + j);
+					bottom_up = false;
+				}
+
+				// threads that get no share of the work leave their counters untouched
+				std::fill(state.found.begin(), state.found.end(), 0);
+				std::fill(state.found_edges.begin(), state.found_edges.end(), 0);
+
+				if (bottom_up)
+					_bfs_bottom_up(depth, tree, state);
+				else
+					_bfs_top_down(depth, tree, state);
+
+				frontier = std::accumulate(state.found.begin(), state.found.end(), std::size_t(0));
+				frontier_edges = std::accumulate(state.found_edges.begin(), state.found_edges.end(),
+												 std::size_t(0));
+				unexplored -= frontier_edges;
+				tree.reached += frontier;
+			}
+
+			return tree;
+		}
+
+		template<class T, class U>
+		friend std::ostream& operator<<(std::ostream& os, const csr_graph<T, U>& g);
+
+	private:
+
+		// the least number of frontier vertices (top-down) or bitmap words (bottom-up) handed to a
+		// thread by bfs()
+		static const std::size_t _BFS_TOP_DOWN_GRAIN = 256;
+		static const std::size_t _BFS_BOTTOM_UP_GRAIN = 64;
+
+		// frontiers and per-thread counters of bfs()
+		struct _bfs_state
+		{
+			_bfs_state(std::size_t words, unsigned threads)
+				: visited(words),
+				  frontier(words, 0),
+				  next(words, 0),
+				  queue(),
+				  queues(threads),
+				  found(threads, 0),
+				  found_edges(threads, 0)
+			{
+				for (auto& w : visited)
+					w.store(0, std::memory_order_relaxed);
+			}
+
+			std::vector<std::atomic<std::uint64_t>> visited;
+			std::vector<std::uint64_t> frontier;
+			std::vector<std::uint64_t> next;
+			std::vector<std::size_t> queue;
+			std::vector<std::vector<std::size_t>> queues;
+			std::vector<std::size_t> found;
+			std::vector<std::size_t> found_edges;
+		};
+
+		// expands the frontier queue, every thread claiming neighbors in the visited bitmap
+		void _bfs_top_down(std::size_t depth, bfs_tree& tree, _bfs_state& state) const
+		{
+			parallel_for(0, state.queue.size(), static_cast<unsigned>(state.queues.size()),
+						 _BFS_TOP_DOWN_GRAIN, [&](std::size_t first, std::size_t last, unsigned t) {
+				std::vector<std::size_t>& out = state.queues[t];
+				std::size_t edges = 0;
+				out.clear();
+
+				for (std::size_t i = first; i < last; i++) {
+					std::size_t c = state.queue[i];
+
+					for (std::size_t k = _offsets[c]; k < _offsets[c + 1]; k++) {
+						std::size_t v = _adjacency[k];
+						std::uint64_t bit = std::uint64_t(1) << (v % 64);
+						std::atomic<std::uint64_t>& word = state.visited[v / 64];
+
+						if ((word.load(std::memory_order_relaxed) & bit)
+							|| (word.fetch_or(bit, std::memory_order_relaxed) & bit))
+							continue;
+
+						tree.level[v] = depth;
+						tree.parent_edge[v] = _adjacency_edges[k];
+						out.push_back(v);
+						edges += degree(v);
+					}
+				}
+
+				state.found[t] = out.size();
+				state.found_edges[t] = edges;
+			});
+
+			state.queue.clear();
+
+			for (auto& q : state.queues) {
+				state.queue.insert(state.queue.end(), q.begin(), q.end());
+				q.clear();
+			}
+		}
+
+		// lets every unvisited vertex look for a parent in the frontier bitmap; threads own whole
+		// bitmap words, so the visited and next frontier words need no synchronization
+		void _bfs_bottom_up(std::size_t depth, bfs_tree& tree, _bfs_state& state) const
+		{
+			std::size_t n = vertex_count();
+
+			parallel_for(0, state.next.size(), static_cast<unsigned>(state.queues.size()),
+						 _BFS_BOTTOM_UP_GRAIN, [&](std::size_t first, std::size_t last, unsigned t) {
+				std::size_t found = 0, edges = 0;
+
+				for (std::size_t w = first; w < last; w++) {
+					std::uint64_t seen = state.visited[w].load(std::memory_order_relaxed), hits = 0;
+
+					for (std::size_t j = 0; j < 64 && ~seen; j++) {
+						std::size_t v = w * 64 + j;
+
+						if ((seen >> j & 1) || v >= n)
+							continue;
+
+						for (std::size_t k = _offsets[v]; k < _offsets[v + 1]; k++) {
+							std::size_t u = _adjacency[k];
+
+							if (state.frontier[u / 64] >> (u % 64) & 1) {
+								tree.level[v] = depth;
+								tree.parent_edge[v] = _adjacency_edges[k];
+								hits |= std::uint64_t(1) << j;
+								found++;
+								edges += degree(v);
+								break;
+							}
+						}
+					}
+
+					state.next[w] = hits;
+					state.visited[w].store(seen | hits, std::memory_order_relaxed);
+				}
+
+				state.found[t] = found;
+				state.found_edges[t] = edges;
+			});
+
+			state.frontier.swap(state.next);
+		}
+
+		// per-thread scratch space of the multi-source searches
+		struct _row_workspace
+		{
+			indexed_heap<double> heap;
+			std::vector<std::size_t> queue;
+			std::vector<double> distance;
+			std::vector<std::size_t> predecessor;
+		};
+
+		distance_matrix _matrix(std::size_t rows) const
+		{
+			distance_matrix m;
+			m.rows = rows;
+			m.columns = vertex_count();
+			m.distance.resize(rows * m.columns);
+			m.predecessor.resize(rows * m.columns);
+			return m;
+		}
+
+		// runs f(r, workspace) for every source index r, sources spread dynamically over threads
+		template<typename S>
+		void _for_each_source(const std::vector<std::size_t>& sources, unsigned threads, S f) const
+		{
+			if (threads == 0)
+				threads = hardware_threads();
+
+			std::vector<_row_workspace> ws(std::max<std::size_t>(1, std::min<std::size_t>(threads,
+																						 sources.size())));
+
+			for (_row_workspace& w : ws) {
+				w.distance.resize(vertex_count());
+				w.predecessor.resize(vertex_count());
+			}
+
+			parallel_for_each(0, sources.size(), static_cast<unsigned>(ws.size()),
+				[&](std::size_t r, unsigned t) {
+					if (sources[r] >= vertex_count())
+						throw exception("csr_graph: source index " + std::to_string(sources[r])
+										+ " does not exist.");
+					f(r, ws[t]);
+				});
+		}
+
+		// Dijkstra's algorithm from *s* to all vertices, writing one row of a distance_matrix
+		template<typename W, typename F>
+		void _dijkstra_row(std::size_t s, W weight, F cstr, double* distance,
+						   std::size_t* predecessor, _row_workspace& ws) const
+		{
+			std::fill(distance, distance + vertex_count(), std::numeric_limits<double>::infinity());
+			std::fill(predecessor, predecessor + vertex_count(), npos);
+
+			ws.heap.reset(vertex_count());
+			distance[s] = 0;
+			ws.heap.push(s, 0);
+
+			// settled vertices are never improved upon, so they need no separate marks
+			while (!ws.heap.empty()) {
+				double d = ws.heap.top_key();
+				std::size_t c = ws.heap.pop();
+
+				for (std::size_t k = _offsets[c]; k < _offsets[c + 1]; k++) {
+					std::size_t v = _adjacency[k], e = _adjacency_edges[k];
+
+					if (!cstr(&_edges[e]))
+						continue;
+
+					double w = weight(&_edges[e]);
+
+					if (w < 0)
+						throw exception("csr_graph::distances(): negative edge weight");
+
+					if (d + w < distance[v]) {
+						distance[v] = d + w;
+						predecessor[v] = e;
+						ws.heap.push_or_decrease(v, d + w);
+					}
+				}
+			}
+		}
+
+		// breadth-first search from *s* to all vertices, writing one row of a distance_matrix
+		template<typename F>
+		void _bfs_row(std::size_t s, F cstr, double* distance, std::size_t* predecessor,
+					  _row_workspace& ws) const
+		{
+			std::fill(distance, distance + vertex_count(), std::numeric_limits<double>::infinity());
+			std::fill(predecessor, predecessor + vertex_count(), npos);
+
+			ws.queue.resize(vertex_count());
+			std::size_t head = 0, tail = 0;
+			distance[s] = 0;
+			ws.queue[tail++] = s;
+
+			while (head != tail) {
+				std::size_t c = ws.queue[head++];
+
+				for (std::size_t k = _offsets[c]; k < _offsets[c + 1]; k++) {
+					std::size_t v = _adjacency[k], e = _adjacency_edges[k];
+
+					if (std::isinf(distance[v]) && cstr(&_edges[e])) {
+						distance[v] = distance[c] + 1;
+						predecessor[v] = e;
+						ws.queue[tail++] = v;
+					}
+				}
+			}
+		}
+
+		template<typename F>
+		bool _bfs(std::size_t start, std::size_t target, F cstr, search_workspace& ws) const
+		{
+			ws._reset(vertex_count());
+			ws._visited[start] = ws._epoch;
+
+			if (start == target)
+				return true;
+
+			std::size_t head = 0, tail = 0;
+			ws._frontier[tail++] = start;
+
+			while (head != tail) {
+				std::size_t c = ws._frontier[head++];
+
+				for (std::size_t k = _offsets[c]; k < _offsets[c + 1]; k++) {
+					std::size_t v = _adjacency[k], e = _adjacency_edges[k];
+
+					if (ws._visited[v] != ws._epoch && cstr(&_edges[e])) {
+						ws._visited[v] = ws._epoch;
+						ws._parent[v] = e;
+
+						if (v == target)
+							return true;
+
+						ws._frontier[tail++] = v;
+					}
+				}
+			}
+
+			return false;
+		}
+
+		// the values are written through *os*, so its precision and flags apply
+		void _print_adjacency_list(std::ostream& os) const
+		{
+			for (std::size_t v = 0; v < vertex_count(); v++) {
+				os << " " << _vertices[v] << " -> [ ";
+				for (std::size_t i = 0; i < degree(v); i++) {
+					os << _vertices[_adjacency[_offsets[v] + i]]
+					   << (i + 1 < degree(v) ? ", " : " ");
+				}
+				os << "]\n";
+			}
+		}
+
+		// an array either owning its elements, while the snapshot is built by Graph::freeze(), or
+		// viewing elements owned by someone else, such as a file mapped by open()
+		template<class T>
+		class _array
+		{
+		public:
+
+			_array()
+				: _owned(),
+				  _data(nullptr),
+				  _size(0)
+			{ }
+
+			_array(std::size_t n, const T& value)
+				: _owned(n, value),
+				  _data(_owned.data()),
+				  _size(n)
+			{ }
+
+			_array(const _array& other)
+				: _owned(other._owned),
+				  _data(other._owned.empty() ? other._data : _owned.data()),
+				  _size(other._size)
+			{ }
+
+			_array(_array&& other)
+				: _owned(std::move(other._owned)),
+				  _data(other._data),
+				  _size(other._size)
+			{
+				other._data = nullptr;
+				other._size = 0;
+			}
+
+			_array& operator=(_array other)
+			{
+				_owned.swap(other._owned);
+				std::swap(_data, other._data);
+				std::swap(_size, other._size);
+				return *this;
+			}
+
+			// only arrays owning their elements are ever written
+			inline T& operator[](std::size_t i)
+			{
+				return const_cast<T*>(_data)[i];
+			}
+
+			inline const T& operator[](std::size_t i) const
+			{
+				return _data[i];
+			}
+
+			inline const T* data() const
+			{
+				return _data;
+			}
+
+			inline const T* begin() const
+			{
+				return _data;
+			}
+
+			inline const T* end() const
+			{
+				return _data + _size;
+			}
+
+			inline const T& back() const
+			{
+				return _data[_size - 1];
+			}
+
+			inline std::size_t size() const
+			{
+				return _size;
+			}
+
+			void reserve(std::size_t n)
+			{
+				_owned.reserve(n);
+				_sync();
+			}
+
+			void push_back(const T& value)
+			{
+				_owned.push_back(value);
+				_sync();
+			}
+
+			void assign(std::size_t n, const T& value)
+			{
+				_owned.assign(n, value);
+				_sync();
+			}
+
+			void resize(std::size_t n)
+			{
+				_owned.resize(n);
+				_sync();
+			}
+
+			// makes the array refer to *n* elements at *data* it does not own
+			void _view(const T* data, std::size_t n)
+			{
+				std::vector<T>().swap(_owned);
+				_data = data;
+				_size = n;
+			}
+
+		private:
+
+			inline void _sync()
+			{
+				_data = _owned.data();
+				_size = _owned.size();
+			}
+
+			std::vector<T> _owned;
+			const T* _data;
+			std::size_t _size;
+		};
+
+		// the number of arrays stored by save()
+		static const std::size_t _BINARY_SECTIONS = 11;
+
+		// the flags of the binary format
+		static const std::uint32_t _BINARY_DIRECTED = 1;
+
+		// the header at the start of a file written by save(), sections are given as byte offsets
+		// from the start of the file in the order they are listed in save()
+		struct _binary_header
+		{
+			char magic[8];
+			std::uint32_t version;
+			std::uint32_t byte_order;
+			std::uint32_t word_size;
+			std::uint32_t flags;
+			std::uint64_t index_mask;
+			std::uint64_t vertex_count;
+			std::uint64_t edge_count;
+			std::uint64_t adjacency_size;
+			std::uint64_t vertex_index_size;
+			std::uint64_t edge_index_size;
+			std::uint64_t vertex_size;
+			std::uint64_t edge_size;
+			std::uint64_t section[_BINARY_SECTIONS];
+		};
+
+		// returns the header fields identifying the format, platform and payload types
+		static _binary_header _header()
+		{
+			_binary_header h;
+
+			std::memset(&h, 0, sizeof(h));
+			std::memcpy(h.magic, "PLEXUMG", 8);
+			h.version = BINARY_VERSION;
+			h.byte_order = 0x01020304;
+			h.word_size = sizeof(std::size_t);
+			h.vertex_size = sizeof(VertexType);
+			h.edge_size = sizeof(EdgeType);
+			return h;
+		}
+
+		// returns section *i* of the mapped file at *base* after checking it holds *n* elements
+		template<class T>
+		static const T* _section(const std::string& path, const char* base, std::size_t size,
+								 const _binary_header& h, std::size_t i, std::uint64_t n)
+		{
+			static_assert(alignof(T) <= SECTION_ALIGNMENT, "payload alignment exceeds sections");
+
+			std::uint64_t first = h.section[i];
+
+			if (first % SECTION_ALIGNMENT != 0 || first > size || n > (size - first) / sizeof(T))
+				throw exception("csr_graph::open(): " + path + " is truncated or corrupt");
+
+			return reinterpret_cast<const T*>(base + first);
+		}
+
+		template<class T>
+		static inline const char* _bytes(const _array<T>& a)
+		{
+			return reinterpret_cast<const char*>(a.data());
+		}
+
+		static inline std::uint64_t _align(std::uint64_t offset)
+		{
+			return (offset + SECTION_ALIGNMENT - 1) / SECTION_ALIGNMENT * SECTION_ALIGNMENT;
+		}
+
+		_array<std::size_t> _offsets;
+		_array<std::size_t> _adjacency;
+		_array<std::size_t> _adjacency_edges;
+		_array<std::size_t> _source;
+		_array<std::size_t> _target;
+		_array<std::size_t> _vertex_ids;
+		_array<std::size_t> _edge_ids;
+
+		// storage index of an id in the originating graph -> dense index, the storage index is
+		// the id with all bits outside _index_mask cleared
+		_array<std::size_t> _vertex_index;
+		_array<std::size_t> _edge_index;
+		std::size_t _index_mask;
+		bool _directed;
+
+		_array<VertexType> _vertices;
+		_array<EdgeType> _edges;
+
+		search_workspace _workspace;
+
+		// the mapping the arrays refer to if the snapshot was opened from a file
+		std::shared_ptr<const mapped_file> _file;
+	};
+
+	template<class VertexType, class EdgeType>
+	const std::size_t csr_graph<VertexType, EdgeType>::npos;
+
+	template<class VertexType, class EdgeType>
+	const std::size_t csr_graph<VertexType, EdgeType>::BFS_ALPHA;
+
+	template<class VertexType, class EdgeType>
+	const std::size_t csr_graph<VertexType, EdgeType>::BFS_BETA;
+
+	template<class VertexType, class EdgeType>
+	const std::uint32_t csr_graph<VertexType, EdgeType>::BINARY_VERSION;
+
+	template<class VertexType, class EdgeType>
+	const std::size_t csr_graph<VertexType, EdgeType>::SECTION_ALIGNMENT;
+
+	template<class VertexType, class EdgeType>
+	std::ostream& operator<<(std::ostream& os, const csr_graph<VertexType, EdgeType>& g)
+	{
+		os << "Graph(n=" << g.vertex_count() << ", m=" << g.edge_count() << ")\n";
+		g._print_adjacency_list(os);
+		return os;
+	}
+}
+
+#endif
@@ -0,0 +1,306 @@
+/*
+ * plexum graph library
+ *
+ * oliver dot michel at colorado dot edu
+ *
+ * MIT License
+ */
+
+#ifndef PLEXUM_EDGE_LIST_H
+#define PLEXUM_EDGE_LIST_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include <plexum/exception.h>
+#include <plexum/graph.h>
+#include <plexum/mapped_file.h>
+#include <plexum/parallel.h>
+
+namespace plexum
+{
+	//! @cond
+
+	// a parsed line of an edge list
+	struct _edge_list_entry
+	{
+		std::uint64_t from;
+		std::uint64_t to;
+		double weight;
+	};
+
+	// the lines parsed by one thread, and the offset of its first malformed line if any
+	struct _edge_list_chunk
+	{
+		_edge_list_chunk()
+			: entries(),
+			  error(std::string::npos)
+		{ }
+
+		std::vector<_edge_list_entry> entries;
+		std::size_t error;
+	};
+
+	inline bool _is_blank(char c)
+	{
+		return c == ' ' || c == '\t' || c == '\r';
+	}
+
+	inline bool _is_digit(char c)
+	{
+		return static_cast<unsigned>(c - '0') < 10;
+	}
+
+	// parses an unsigned decimal integer at *p*, returns false if there is none or it overflows
+	inline bool _parse_label(const char*& p, const char* end, std::uint64_t& value)
+	{
+		if (p == end || !_is_digit(*p))
+			return false;
+
+		value = 0;
+
+		for (; p != end && _is_digit(*p); ++p) {
+			std::uint64_t d = static_cast<std::uint64_t>(*p - '0');
+
+			if (value > (std::numeric_limits<std::uint64_t>::max() - d) / 10)
+				return false;
+
+			value = value * 10 + d;
+		}
+
+		return true;
+	}
+
+	// parses a decimal number with optional sign, fraction and exponent at *p*
+	// numbers whose digits fit into 53 bits and whose exponent is at most 22 in magnitude are
+	// converted with a single correctly rounded multiplication or division, all others through
+	// std::strtod(), so the result always equals that of std::strtod()
+	inline bool _parse_weight(const char*& p, const char* end, double& value)
+	{
+		static const double powers[] = {
+			1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+			1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+		};
+		const std::uint64_t exact = std::uint64_t(1) << 53;
+		const char* start = p;
+		bool negative = p != end && *p == '-';
+
+		if (p != end && (*p == '-' || *p == '+'))
+			++p;
+
+		std::uint64_t mantissa = 0;
+		int exponent = 0;
+		bool digits = false;
+		bool fast = true;
+
+		auto digit = [&](char c) {
+			if (mantissa < exact)
+				mantissa = mantissa * 10 + static_cast<std::uint64_t>(c - '0');
+			else
+				fast = false;
+		};
+
+		for (; p != end && _is_digit(*p); ++p, digits = true)
+			digit(*p);
+
+		if (p != end && *p == '.')
+			for (++p; p != end && _is_digit(*p); ++p, digits = true, exponent--)
+				digit(*p);
+
+		if (!digits)
+			return false;
+
+		if (p != end && (*p == 'e' || *p == 'E')) {
+			++p;
+			bool negative_exponent = p != end && *p == '-';
+
+			if (p != end && (*p == '-' || *p == '+'))
+				++p;
+
+			if (p == end || !_is_digit(*p))
+				return false;
+
+			int e = 0;
+
+			for (; p != end && _is_digit(*p); ++p)
+				e = std::min(e * 10 + (*p - '0'), 100000);
+
+			exponent += negative_exponent ? -e : e;
+		}
+
+		if (fast && mantissa <= exact && exponent >= -22 && exponent <= 22) {
+			double m = static_cast<double>(mantissa);
+			value = exponent < 0 ? m / powers[-exponent] : m * powers[exponent];
+			value = negative ? -value : value;
+			return true;
+		}
+
+		// the text is not null-terminated, so the number is copied before converting it
+		std::string token(start, p);
+		value = std::strtod(token.c_str(), nullptr);
+		return true;
+	}
+
+	// parses the lines starting in [first, last) of the text at [begin, end) into *chunk*
+	inline void _parse_edge_list(const char* begin, const char* end, std::size_t first,
+								 std::size_t last, _edge_list_chunk& chunk)
+	{
+		const char* p = begin + first;
+
+		// a line crossing the start of the block belongs to the previous block
+		if (first > 0 && p[-1] != '\n')
+			while (p != end && *p++ != '\n') { }
+
+		while (p < begin + last) {
+			const char* line = p;
+			_edge_list_entry e;
+
+			while (p != end && _is_blank(*p))
+				++p;
+
+			if (p == end || *p == '\n' || *p == '#' || *p == '%') {
+				while (p != end && *p++ != '\n') { }
+				continue;
+			}
+
+			bool valid = _parse_label(p, end, e.from) && p != end && _is_blank(*p);
+
+			while (valid && p != end && _is_blank(*p))
+				++p;
+
+			valid = valid && _parse_label(p, end, e.to);
+			e.weight = 1;
+
+			if (valid && p != end && _is_blank(*p)) {
+				while (p != end && _is_blank(*p))
+					++p;
+
+				if (p != end && *p != '\n')
+					valid = _parse_weight(p, end, e.weight);
+			}
+
+			// columns after the weight, such as SNAP timestamps, are ignored
+			valid = valid && (p == end || *p == '\n' || _is_blank(*p));
+
+			if (!valid) {
+				chunk.error = static_cast<std::size_t>(line - begin);
+				return;
+			}
+
+			chunk.entries.push_back(e);
+
+			while (p != end && *p++ != '\n') { }
+		}
+	}
+
+	//! @endcond
+
+	//
+	// plexum::read_edge_list()
+	//
+
+	/*! @brief adds the edges listed in the text file at *path* to *g*
+	 *  @details Every line holds the labels of two vertices, optionally followed by a weight,
+	 *           separated by spaces or tabs, as in the SNAP datasets. Labels are unsigned 64-bit
+	 *           integers and need not be contiguous. Every label gets a new vertex constructed
+	 *           from it, and every line an edge constructed from its weight, or from 1 if the
+	 *           line has none. Further columns are ignored, as are blank lines and lines
+	 *           starting with '#' or '%'.
+	 *
+	 *           The file is mapped into memory and split into blocks parsed by up to *threads*
+	 *           threads (0 selects one per hardware thread). Vertices are created in order of
+	 *           first appearance, and the edges are added through edges.add_range().
+	 *  @return the id of the vertex created for each label
+	 *  @throws exception if the file cannot be read or holds a malformed line, in which case
+	 *          the graph is left unchanged
+	 */
+	template<class VertexType, class EdgeType, template<class> class Storage, class Direction>
+	std::unordered_map<std::uint64_t, std::size_t> read_edge_list(
+		Graph<VertexType, EdgeType, Storage, Direction>& g, const std::string& path,
+		unsigned threads = 0)
+	{
+		static const std::size_t GRAIN = 1 << 20;
+
+		mapped_file file(path);
+		const char* begin = file.data();
+		const char* end = begin + file.size();
+
+		if (threads == 0)
+			threads = hardware_threads();
+
+		std::vector<_edge_list_chunk> chunks(threads);
+
+		parallel_for(0, file.size(), threads, GRAIN,
+			[&](std::size_t first, std::size_t last, unsigned t) {
+				chunks[t].entries.reserve((last - first) / 16);
+				_parse_edge_list(begin, end, first, last, chunks[t]);
+			}
+		);
+
+		for (auto& c : chunks) {
+			if (c.error != std::string::npos) {
+				std::size_t line = std::count(begin, begin + c.error, '\n') + 1;
+				throw exception("read_edge_list(): malformed line " + std::to_string(line)
+								+ " in " + path);
+			}
+		}
+
+		// labels are numbered sequentially in order of first appearance, and the entries are
+		// rewritten to hold these numbers instead of the labels
+		std::unordered_map<std::uint64_t, std::size_t> index;
+		std::vector<std::uint64_t> labels;
+		std::size_t m = 0;
+
+		for (auto& c : chunks)
+			m += c.entries.size();
+
+		index.reserve(m / 4);
+
+		for (auto& c : chunks) {
+			for (auto& e : c.entries) {
+				auto from = index.emplace(e.from, labels.size());
+				if (from.second)
+					labels.push_back(e.from);
+				e.from = from.first->second;
+
+				auto to = index.emplace(e.to, labels.size());
+				if (to.second)
+					labels.push_back(e.to);
+				e.to = to.first->second;
+			}
+		}
+
+		std::vector<VertexType> values;
+		values.reserve(labels.size());
+
+		for (std::uint64_t l : labels)
+			values.push_back(static_cast<VertexType>(l));
+
+		std::vector<std::size_t> ids = g.vertices.add_range(values.begin(), values.end(), threads);
+		std::vector<std::tuple<std::size_t, std::size_t, EdgeType>> edges;
+		edges.reserve(m);
+
+		for (auto& c : chunks) {
+			for (auto& e : c.entries)
+				edges.emplace_back(ids[e.from], ids[e.to], static_cast<EdgeType>(e.weight));
+
+			std::vector<_edge_list_entry>().swap(c.entries);
+		}
+
+		g.edges.add_range(edges.begin(), edges.end(), threads);
+
+		for (auto& p : index)
+			p.second = ids[p.second];
+
+		return index;
+	}
+}
+
+#endif
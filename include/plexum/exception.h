@@ -0,0 +1,52 @@
+/*
+ * plexum graph library
+ *
+ * oliver dot michel at colorado dot edu
+ *
+ * MIT License
+ */
+
+#ifndef PLEXUM_EXCEPTION_H
+#define PLEXUM_EXCEPTION_H
+
+#include <exception>
+#include <string>
+
+namespace plexum
+{
+	//
+	// plexum::exception
+	//
+
+	/*! @brief A custom exception class
+	 *  @details inherits from std::exception
+	 */
+	class exception : public std::exception
+	{
+	public:
+
+		explicit exception(const char* what)
+			: _what(what)
+		{ }
+
+		explicit exception(const std::string& what)
+			: _what(what)
+		{ }
+
+		/*! @brief returns the error message associated with the exception
+		 * @return a character array containing the error message associated with the exception
+		 */
+		virtual const char* what() const throw()
+		{
+			return _what.c_str();
+		}
+
+		virtual ~exception() throw()
+		{ }
+
+	private:
+		std::string _what;
+	};
+}
+
+#endif
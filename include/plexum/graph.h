@@ -10,66 +10,119 @@
 #define PLEXUM_GRAPH_H
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
 #include <iostream>
+#include <limits>
 #include <map>
+#include <memory>
 #include <vector>
 #include <numeric>
-#include <list>
+#include <set>
+#include <tuple>
+#include <type_traits>
+
+#include <plexum/csr.h>
+#include <plexum/exception.h>
+#include <plexum/heap.h>
+#include <plexum/lru_cache.h>
+#include <plexum/memory.h>
+#include <plexum/output.h>
+#include <plexum/parallel.h>
+#include <plexum/storage.h>
+#include <plexum/union_find.h>
 
 namespace plexum
 {
+	/*! @brief path search strategy tag selecting a search that expands from both endpoints
+	 *         until the two searches meet
+	 */
+	struct bidirectional_search { };
+
+	/*! @brief identifies the constraint of a cached path query, see Graph::enable_path_cache() */
+	struct path_tag
+	{
+		explicit path_tag(std::size_t id)
+			: id(id)
+		{ }
+
+		std::size_t id;
+	};
+
+	/*! @brief the counters of a Graph's path cache */
+	struct path_cache_stats
+	{
+		std::size_t hits;			//!< queries answered from the cache
+		std::size_t misses;			//!< queries that ran a search
+		std::size_t evictions;		//!< entries dropped to make room for newer ones
+		std::size_t invalidations;	//!< entries dropped because the graph changed
+	};
+
+	//
+	// plexum::undirected, plexum::directed, plexum::bidirectional
+	//
+
+	/*! @brief direction policy of undirected graphs
+	 *  @details every vertex keeps a single incidence list holding an entry for each incident edge
+	 */
+	struct undirected
+	{
+		static const bool is_directed = false;
+		static const bool in_edges = false;
+	};
+
+	/*! @brief direction policy of directed graphs keeping only the out-adjacency
+	 *  @details an edge is stored once, in the adjacency list of its source. Searches expanding
+	 *           from the target, i.e. bidirectional searches and k_shortest_paths(), do not
+	 *           compile for such graphs, and removing a vertex with incoming edges with
+	 *           remove_with_edges() scans the whole graph.
+	 */
+	struct directed
+	{
+		static const bool is_directed = true;
+		static const bool in_edges = false;
+	};
+
+	/*! @brief direction policy of directed graphs keeping both the out- and the in-adjacency
+	 *  @details an edge is stored in the out-list of its source and the in-list of its target
+	 */
+	struct bidirectional
+	{
+		static const bool is_directed = true;
+		static const bool in_edges = true;
+	};
+
 	//
-	// plexum::Graph<VertexType, EdgeType>
+	// plexum::Graph<VertexType, EdgeType, Storage, Direction>
 	//
 
-	/*! @brief The undirected graph class.
+	/*! @brief The graph class.
 	 *  @tparam VertexType the vertex type
 	 *  @tparam EdgeType the edge type
+	 *  @tparam Storage the element storage backend, either plexum::map_storage (ordered,
+	 *          O(log n) lookups) or plexum::slot_storage (dense, O(1) lookups)
+	 *  @tparam Direction the direction policy, plexum::undirected (the default),
+	 *          plexum::directed or plexum::bidirectional. It is resolved at compile time, so
+	 *          operations depending on it do not branch on it at runtime.
 	 */
-	template<class VertexType, class EdgeType>
+	template<class VertexType, class EdgeType, template<class> class Storage = map_storage,
+			 class Direction = undirected>
 	class Graph
 	{
 	public:
 
-		/*! @brief initialization for the internal vertex/edge index management */
+		/*! @brief the id of the first vertex and the first edge added to an empty graph */
 		static const std::size_t ELEMENT_INDEX_INIT = 0;
 
-		//
-		// plexum::Graph<VertexType, EdgeType>::exception
-		//
-
-		/*! @brief A custom exception class
-		 *  @details inherits from std::exception
-		 */
-		class exception : public std::exception
-		{
-		public:
-
-			explicit exception(const char* what)
-				: _what(what)
-			{ }
-
-			explicit exception(const std::string& what)
-				: _what(what)
-			{ }
-
-			/*! @brief returns the error message associated with the exception
-			 * @return a character array containing the error message associated with the exception
-			 */
-			virtual const char* what() const throw()
-			{
-				return _what.c_str();
-			}
-
-			virtual ~exception() throw()
-			{ }
+		/*! @brief the minimum number of elements processed per thread by parallel operations */
+		static const std::size_t PARALLEL_GRAIN = 1 << 16;
 
-		private:
-			std::string _what;
-		};
+		/*! @brief the exception type thrown by graph operations */
+		typedef plexum::exception exception;
 
 		//
-		// plexum::Graph<VertexType, EdgeType>::container<T>
+		// plexum::Graph<VertexType, EdgeType, Storage, Direction>::container<T>
 		//
 
 		//! @cond
@@ -77,120 +130,207 @@ namespace plexum
 		template<class T>
 		class container
 		{
-			friend class Graph<VertexType, EdgeType>;
+			friend class Graph<VertexType, EdgeType, Storage, Direction>;
 		public:
 
 			container() = delete;
 
-			container(unsigned id, T e)
+			container(std::size_t id, T e)
 				: _id(id),
 				  _element(e)
 			{ }
 
 		protected:
-			unsigned _id;
+			std::size_t _id;
 			T _element;
 		};
 
-		// forward declare edge_container for referenceability in vertex_container
+		// forward declare the containers for referenceability in adjacency entries
+		template<class> class vertex_container;
 		template<class> class edge_container;
 
+		// an entry of an adjacency list: the neighbor, the edge leading to it and the side
+		// of the edge the entry belongs to, 0 for the entry of _from and 1 for that of _to
+		struct _adjacency
+		{
+			vertex_container<VertexType>* vertex;
+			edge_container<EdgeType>*     edge;
+			unsigned                      side;
+		};
+
+		typedef std::vector<_adjacency, resource_allocator<_adjacency>> _adjacency_list;
+
+		// an entry of an edge's embedding: the edge it is mapped onto or that is mapped onto it,
+		// and the position of the reciprocal entry in the embedding of that edge
+		struct _embedding
+		{
+			edge_container<EdgeType>* edge;
+			std::size_t               position;
+		};
+
+		typedef std::vector<_embedding, resource_allocator<_embedding>> _embedding_list;
+
+		// the state the direction policy adds to a vertex, nothing for undirected graphs whose
+		// incidence list holds the entries of both sides
+		template<class D, class = void>
+		class _incoming_state
+		{
+		protected:
+
+			explicit _incoming_state(memory_resource*)
+			{ }
+		};
+
+		// directed graphs only count the incoming edges, which are stored by their sources
+		template<class Dummy>
+		class _incoming_state<directed, Dummy>
+		{
+		protected:
+
+			explicit _incoming_state(memory_resource*)
+				: _in_degree(0)
+			{ }
+
+			std::size_t _in_degree;
+		};
+
+		// bidirectional graphs keep the side 1 entries in an in-adjacency list of their own
+		template<class Dummy>
+		class _incoming_state<bidirectional, Dummy>
+		{
+		protected:
+
+			explicit _incoming_state(memory_resource* r)
+				: _in_neighbors(resource_allocator<_adjacency>(r))
+			{ }
+
+			_adjacency_list _in_neighbors;
+		};
+
 		//
-		// plexum::Graph<VertexType, EdgeType>::vertex_container
+		// plexum::Graph<VertexType, EdgeType, Storage, Direction>::vertex_container
 		//
 
 		template<class>
-		class vertex_container : public container<VertexType>
+		class vertex_container : public container<VertexType>, public _incoming_state<Direction>
 		{
-			friend class Graph<VertexType, EdgeType>;
+			friend class Graph<VertexType, EdgeType, Storage, Direction>;
 			friend class vertex_proxy;
 
 		public:
 
-			vertex_container(unsigned id, VertexType e)
+			typedef _adjacency adjacency;
+
+			typedef _adjacency_list adjacency_list;
+
+			typedef std::vector<vertex_container<VertexType>*,
+								resource_allocator<vertex_container<VertexType>*>> vertex_list;
+
+			vertex_container(std::size_t id, VertexType e,
+							 memory_resource* r = new_delete_resource())
 				: container<VertexType>(id, e),
-				  _neighbors(),
-				  _in_edges(),
-				  _out_edges(),
+				  _incoming_state<Direction>(r),
+				  _neighbors(resource_allocator<adjacency>(r)),
 				  _super_vertex(),
-				  _sub_vertices()
+				  _super_position(0),
+				  _demand(0),
+				  _sub_vertices(resource_allocator<vertex_container<VertexType>*>(r)),
+				  _load(0)
 			{ }
 
 		private:
 
-			void _add_neighbor(vertex_container<VertexType>* n)
+			// appends an entry for *e* to *l* and records its position in the edge
+			static void _add_entry(adjacency_list& l, vertex_container<VertexType>* n,
+								   edge_container<EdgeType>* e, unsigned side)
 			{
-				_neighbors.push_back(n);
+				e->_position[side] = l.size();
+				l.push_back({n, e, side});
 			}
 
-			void _remove_neighbor(vertex_container<VertexType>* n)
+			// removes the entry at *pos* of *l* in O(1) by moving the last entry into its place
+			static void _remove_entry(adjacency_list& l, std::size_t pos)
 			{
-				_neighbors.erase(std::find(_neighbors.begin(), _neighbors.end(), n));
+				l[pos] = l.back();
+				l[pos].edge->_position[l[pos].side] = pos;
+				l.pop_back();
 			}
 
-			void _add_in_edge(edge_container<EdgeType>* e)
+			// maps *v* onto the vertex, adding *demand* to its load
+			void _add_sub_vertex(vertex_container<VertexType>* v, double demand)
 			{
-				_in_edges.push_back(e);
+				v->_super_vertex = this;
+				v->_super_position = _sub_vertices.size();
+				v->_demand = demand;
+				_sub_vertices.push_back(v);
+				_load += demand;
 			}
 
-			void _remove_in_edge(edge_container<EdgeType>* e)
+			// unmaps the sub vertex *v* in O(1) by moving the last sub vertex into its place
+			void _remove_sub_vertex(vertex_container<VertexType>* v)
 			{
-				_in_edges.erase(std::find(_in_edges.begin(), _in_edges.end(), e));
-			}
+				std::size_t pos = v->_super_position;
 
-			void _add_out_edge(edge_container<EdgeType>* e)
-			{
-				_out_edges.push_back(e);
-			}
+				_sub_vertices[pos] = _sub_vertices.back();
+				_sub_vertices[pos]->_super_position = pos;
+				_sub_vertices.pop_back();
 
-			void _remove_out_edge(edge_container<EdgeType>* e)
-			{
-				_out_edges.erase(std::find(_out_edges.begin(), _out_edges.end(), e));
+				// an unloaded vertex does not keep the rounding errors of the removed demands
+				_load = _sub_vertices.empty() ? 0 : _load - v->_demand;
+				v->_super_vertex = nullptr;
 			}
 
-			void _add_sub_vertex(vertex_container<VertexType>* v)
+			// unmaps the vertex from its super vertex and all sub vertices from the vertex, before
+			// it is removed from its graph
+			void _detach()
 			{
-				_sub_vertices.push_back(v);
-			}
+				if (_super_vertex != nullptr)
+					_super_vertex->_remove_sub_vertex(this);
 
-			void _remove_sub_vertex(vertex_container<VertexType>* v)
-			{
-				_sub_vertices.erase(std::find(_sub_vertices.begin(), _sub_vertices.end(), v));
+				while (!_sub_vertices.empty())
+					_remove_sub_vertex(_sub_vertices.back());
 			}
 
-			void _set_super_vertex(vertex_container<VertexType>* v)
-			{
-				_super_vertex = v;
-			}
+			// the out-adjacency of directed graphs, the incidence list of undirected ones
+			adjacency_list                             _neighbors;
+			vertex_container<VertexType>*              _super_vertex;
 
-			void _unset_super_vertex()
-			{
-				_super_vertex = nullptr;
-			}
+			// the position of the vertex in the sub vertices of _super_vertex, and the demand it
+			// added to its load
+			std::size_t                                _super_position;
+			double                                     _demand;
 
-			std::vector<vertex_container<VertexType>*> _neighbors;
-			std::vector<edge_container<EdgeType>*>     _in_edges;
-			std::vector<edge_container<EdgeType>*>     _out_edges;
-			vertex_container<VertexType>*              _super_vertex;
-			std::vector<vertex_container<VertexType>*> _sub_vertices;
+			vertex_list                                _sub_vertices;
+
+			// the sum of the demands of _sub_vertices
+			double                                     _load;
 		};
 
 		//
-		// plexum::Graph<VertexType, EdgeType>::edge_container
+		// plexum::Graph<VertexType, EdgeType, Storage, Direction>::edge_container
 		//
 
 		template<class>
 		class edge_container : public container<EdgeType>
 		{
-			friend class Graph<VertexType, EdgeType>;
+			friend class Graph<VertexType, EdgeType, Storage, Direction>;
 			friend class edge_proxy;
+			friend class vertex_container<VertexType>;
 
 		public:
 
-			edge_container(unsigned id, EdgeType e)
+			typedef std::vector<edge_container<EdgeType>*,
+								resource_allocator<edge_container<EdgeType>*>> edge_list;
+
+			edge_container(std::size_t id, EdgeType e, memory_resource* r = new_delete_resource())
 				: container<EdgeType>(id, e),
 				  _from(nullptr),
-				  _to(nullptr)
+				  _to(nullptr),
+				  _position(),
+				  _super_edge(resource_allocator<_embedding>(r)),
+				  _demand(0),
+				  _sub_edges(resource_allocator<_embedding>(r)),
+				  _load(0)
 			{ }
 
 		private:
@@ -215,56 +355,340 @@ namespace plexum
 				_to = nullptr;
 			}
 
-			void _add_sub_edge(edge_container<EdgeType>* e)
+			// appends the edge to the super edges of *e*, adding *demand* to the edge's load
+			void _add_sub_edge(edge_container<EdgeType>* e, double demand)
 			{
-				_sub_edges.push_back(e);
+				_sub_edges.push_back({e, e->_super_edge.size()});
+				e->_super_edge.push_back({this, _sub_edges.size() - 1});
+				e->_demand = demand;
+				_load += demand;
 			}
 
-			void _remove_sub_edge(edge_container<EdgeType>* e)
+			// returns the position of *e* in the super edges of the edge, or npos
+			std::size_t _find_super_edge(edge_container<EdgeType>* e) const
 			{
-				_sub_edges.erase(std::find(_sub_edges.begin(), _sub_edges.end(), e));
+				for (std::size_t i = 0; i < _super_edge.size(); i++)
+					if (_super_edge[i].edge == e)
+						return i;
+
+				return static_cast<std::size_t>(-1);
 			}
 
-			void _set_super_edge(edge_container<EdgeType>* e)
+			// unmaps the edge from its *i*-th super edge. The entry of the super edge is removed
+			// in O(1) by moving its last sub edge into its place, the super edges of the edge
+			// keep their order, as they may form a path.
+			void _remove_super_edge(std::size_t i)
 			{
-				_super_edge = {e};
+				edge_container<EdgeType>* super = _super_edge[i].edge;
+				_embedding_list& subs = super->_sub_edges;
+				std::size_t pos = _super_edge[i].position;
+
+				subs[pos] = subs.back();
+				subs[pos].edge->_super_edge[subs[pos].position].position = pos;
+				subs.pop_back();
+				super->_load = subs.empty() ? 0 : super->_load - _demand;
+
+				_super_edge.erase(_super_edge.begin() + i);
+
+				for (std::size_t k = i; k < _super_edge.size(); k++)
+					_super_edge[k].edge->_sub_edges[_super_edge[k].position].position = k;
 			}
 
-			void _unset_super_edge()
+			// unmaps the edge from all its super edges
+			void _clear_super_edges()
 			{
-				_super_edge.clear();
+				while (!_super_edge.empty())
+					_remove_super_edge(_super_edge.size() - 1);
 			}
 
-			void _add_super_edge(edge_container<EdgeType>* e)
+			// unmaps the edge from its super edges and all sub edges from the edge, before it is
+			// removed from its graph
+			void _detach()
 			{
-				_super_edge.push_back(e);
+				_clear_super_edges();
+
+				while (!_sub_edges.empty())
+					_sub_edges.back().edge->_remove_super_edge(_sub_edges.back().position);
 			}
 
 			vertex_container<VertexType>* _from;
 
 			vertex_container<VertexType>* _to;
 
-			// sub edge may be mapped to a series of super edges
-			std::vector<edge_container<EdgeType>*> _super_edge;
+			// positions of the edge's entries in the adjacency lists of _from and _to
+			std::size_t _position[2];
+
+			// sub edge may be mapped to a series of super edges, and adds _demand to the load of
+			// each of them
+			_embedding_list _super_edge;
+			double _demand;
+
+			_embedding_list _sub_edges;
 
-			std::vector<edge_container<EdgeType>*> _sub_edges;
+			// the sum of the demands of _sub_edges
+			double _load;
 		};
 
+		typedef Storage<vertex_container<VertexType>> vertex_storage;
+
+		typedef Storage<edge_container<EdgeType>> edge_storage;
+
 		//! @endcond
 
 		//
-		// plexum::Graph<VertexType, EdgeType>::vertex_proxy
+		// plexum::Graph<VertexType, EdgeType, Storage, Direction>::vertex_proxy
 		//
 
 		class edge_proxy;
 
+		class search_workspace;
+
 		class vertex_proxy
 		{
-			friend class Graph<VertexType, EdgeType>;
+			friend class Graph<VertexType, EdgeType, Storage, Direction>;
 		public:
 
+			class iterator;
+
+			//
+			// plexum::Graph<VertexType, EdgeType, Storage, Direction>::vertex_proxy::neighbor_range
+			//
+
+			/*! @brief A non-allocating view of the neighbors of a vertex.
+			 *  @details Iterates the adjacency list in place. Each position yields the neighbor and
+			 *           the edge leading to it without any lookups; vertex() and edge() resolve them
+			 *           to full iterators through the graph's storage. The view is invalidated when
+			 *           edges are added to or removed from the vertex.
+			 */
+			class neighbor_range
+			{
+				typedef typename vertex_container<VertexType>::adjacency_list adjacency_list;
+
+			public:
+
+				class const_iterator : public std::iterator<std::forward_iterator_tag, VertexType>
+				{
+					friend class neighbor_range;
+
+				public:
+
+					inline VertexType& operator*() const
+					{
+						return _a->vertex->_element;
+					}
+
+					inline VertexType* operator->() const
+					{
+						return &(_a->vertex->_element);
+					}
+
+					inline const_iterator& operator++()
+					{
+						++_a;
+						return *this;
+					}
+
+					inline const_iterator operator++(int)
+					{
+						const_iterator i = *this;
+						++_a;
+						return i;
+					}
+
+					inline bool operator==(const const_iterator& other) const
+					{
+						return _a == other._a;
+					}
+
+					inline bool operator!=(const const_iterator& other) const
+					{
+						return _a != other._a;
+					}
+
+					/*! @brief returns the id of the neighbor */
+					inline std::size_t id() const
+					{
+						return _a->vertex->_id;
+					}
+
+					/*! @brief returns the element of the edge leading to the neighbor */
+					inline EdgeType& edge_element() const
+					{
+						return _a->edge->_element;
+					}
+
+					/*! @brief returns the id of the edge leading to the neighbor */
+					inline std::size_t edge_id() const
+					{
+						return _a->edge->_id;
+					}
+
+					/*! @brief resolves the neighbor to a vertex iterator */
+					inline typename vertex_proxy::iterator vertex() const
+					{
+						return typename vertex_proxy::iterator(_g, _g->vertices._vertices.find(_a->vertex->_id));
+					}
+
+					/*! @brief resolves the edge leading to the neighbor to an edge iterator */
+					inline typename edge_proxy::iterator edge() const
+					{
+						return typename edge_proxy::iterator(_g, _g->edges._edges.find(_a->edge->_id));
+					}
+
+				private:
+
+					const_iterator(Graph<VertexType, EdgeType, Storage, Direction>* g,
+								   typename adjacency_list::const_iterator a)
+						: _g(g),
+						  _a(a)
+					{ }
+
+					Graph<VertexType, EdgeType, Storage, Direction>* _g;
+					typename adjacency_list::const_iterator _a;
+				};
+
+				neighbor_range(Graph<VertexType, EdgeType, Storage, Direction>* g, const adjacency_list& l)
+					: _g(g),
+					  _l(&l)
+				{ }
+
+				inline const_iterator begin() const
+				{
+					return const_iterator(_g, _l->begin());
+				}
+
+				inline const_iterator end() const
+				{
+					return const_iterator(_g, _l->end());
+				}
+
+				inline std::size_t size() const
+				{
+					return _l->size();
+				}
+
+				inline bool empty() const
+				{
+					return _l->empty();
+				}
+
+			private:
+
+				Graph<VertexType, EdgeType, Storage, Direction>* _g;
+				const adjacency_list* _l;
+			};
+
+			//
+			// plexum::Graph<VertexType, EdgeType, Storage, Direction>::vertex_proxy::edge_range
+			//
+
+			/*! @brief A non-allocating view of the edges incident to a vertex.
+			 *  @details Iterates the adjacency list in place, yielding edge elements and ids
+			 *           without any lookups; edge() resolves a position to a full edge iterator. The
+			 *           view is invalidated when edges are added to or removed from the vertex.
+			 */
+			class edge_range
+			{
+				typedef typename vertex_container<VertexType>::adjacency_list adjacency_list;
+
+			public:
+
+				class const_iterator : public std::iterator<std::forward_iterator_tag, EdgeType>
+				{
+					friend class edge_range;
+
+				public:
+
+					inline EdgeType& operator*() const
+					{
+						return _e->edge->_element;
+					}
+
+					inline EdgeType* operator->() const
+					{
+						return &(_e->edge->_element);
+					}
+
+					inline const_iterator& operator++()
+					{
+						++_e;
+						return *this;
+					}
+
+					inline const_iterator operator++(int)
+					{
+						const_iterator i = *this;
+						++_e;
+						return i;
+					}
+
+					inline bool operator==(const const_iterator& other) const
+					{
+						return _e == other._e;
+					}
+
+					inline bool operator!=(const const_iterator& other) const
+					{
+						return _e != other._e;
+					}
+
+					/*! @brief returns the id of the edge */
+					inline std::size_t id() const
+					{
+						return _e->edge->_id;
+					}
+
+					/*! @brief resolves the position to an edge iterator */
+					inline typename edge_proxy::iterator edge() const
+					{
+						return typename edge_proxy::iterator(_g, _g->edges._edges.find(_e->edge->_id));
+					}
+
+				private:
+
+					const_iterator(Graph<VertexType, EdgeType, Storage, Direction>* g,
+								   typename adjacency_list::const_iterator e)
+						: _g(g),
+						  _e(e)
+					{ }
+
+					Graph<VertexType, EdgeType, Storage, Direction>* _g;
+					typename adjacency_list::const_iterator _e;
+				};
+
+				edge_range(Graph<VertexType, EdgeType, Storage, Direction>* g, const adjacency_list& l)
+					: _g(g),
+					  _l(&l)
+				{ }
+
+				inline const_iterator begin() const
+				{
+					return const_iterator(_g, _l->begin());
+				}
+
+				inline const_iterator end() const
+				{
+					return const_iterator(_g, _l->end());
+				}
+
+				inline std::size_t size() const
+				{
+					return _l->size();
+				}
+
+				inline bool empty() const
+				{
+					return _l->empty();
+				}
+
+			private:
+
+				Graph<VertexType, EdgeType, Storage, Direction>* _g;
+				const adjacency_list* _l;
+			};
+
 			//
-			// plexum::Graph<VertexType, EdgeType>::vertex_proxy::iterator
+			// plexum::Graph<VertexType, EdgeType, Storage, Direction>::vertex_proxy::iterator
 			//
 
 			class iterator
@@ -276,8 +700,8 @@ namespace plexum
 				iterator() = delete;
 
 				iterator(
-					Graph<VertexType, EdgeType>* g,
-					typename std::map<std::size_t, vertex_container<VertexType>>::iterator i
+					Graph<VertexType, EdgeType, Storage, Direction>* g,
+					typename vertex_storage::iterator i
 				)
 					: _g(g),
 					  _i(i)
@@ -323,40 +747,103 @@ namespace plexum
 					return _i->first;
 				}
 
+				/*! @brief checks whether any edge is incident to the vertex, including incoming
+				 *         edges of directed graphs
+				 */
 				bool has_neighbors()
 				{
-					return !(_i->second._neighbors.empty());
+					return !(_i->second._neighbors.empty())
+						|| _g->_in_degree(&_i->second, Direction()) != 0;
+				}
+
+				/*! @brief returns the number of edges incident to the vertex, or of outgoing edges
+				 *         for directed graphs, in O(1)
+				 */
+				inline std::size_t degree()
+				{
+					return _i->second._neighbors.size();
+				}
+
+				/*! @brief returns the number of incoming edges in O(1), which is the degree for
+				 *         undirected graphs
+				 */
+				inline std::size_t in_degree()
+				{
+					return _g->_in_degree(&_i->second, Direction());
+				}
+
+				/*! @brief returns a non-allocating view of the vertex's neighbors, the targets of
+				 *         its outgoing edges for directed graphs
+				 */
+				inline neighbor_range neighbor_view()
+				{
+					return neighbor_range(_g, _i->second._neighbors);
+				}
+
+				/*! @brief returns a non-allocating view of the edges incident to the vertex, its
+				 *         outgoing edges for directed graphs
+				 */
+				inline edge_range edge_view()
+				{
+					return edge_range(_g, _i->second._neighbors);
+				}
+
+				/*! @brief returns a non-allocating view of the sources of the vertex's incoming
+				 *         edges, the same as neighbor_view() for undirected graphs
+				 *  @details not available for plexum::directed graphs
+				 */
+				inline neighbor_range in_neighbor_view()
+				{
+					return neighbor_range(_g, _g->_incoming(&_i->second, Direction()));
+				}
+
+				/*! @brief returns a non-allocating view of the vertex's incoming edges, the same as
+				 *         edge_view() for undirected graphs
+				 *  @details not available for plexum::directed graphs
+				 */
+				inline edge_range in_edge_view()
+				{
+					return edge_range(_g, _g->_incoming(&_i->second, Direction()));
 				}
 
 				std::vector<iterator> neighbors()
 				{
+					neighbor_range r = neighbor_view();
 					std::vector<iterator> s;
+					s.reserve(r.size());
 
-					for (vertex_container<VertexType>* n : _i->second._neighbors)
-						s.push_back(iterator(_graph(), _graph()->vertices._vertices.find(n->_id)));
+					for (auto n = r.begin(); n != r.end(); ++n)
+						s.push_back(n.vertex());
 
 					return s;
 				};
 
 				std::vector<typename edge_proxy::iterator> edges()
 				{
+					edge_range r = edge_view();
 					std::vector<typename edge_proxy::iterator> s;
+					s.reserve(r.size());
+
+					for (auto e = r.begin(); e != r.end(); ++e)
+						s.push_back(e.edge());
 
-					for (edge_container<EdgeType>* e : _i->second._in_edges)
-						s.push_back(typename edge_proxy::iterator(_graph(),
-							_graph()->edges._edges.find(e->_id)));
-					/*
-					for (edge_container<EdgeType>* e : _i->second._out_edges)
-						s.push_back(typename edge_proxy::iterator(_graph(),
-					 		_graph()->edges._edges.find(e->_id)));
-					*/
 					return s;
 				}
 
+				/*! @brief maps the vertex *other* onto the vertex in O(1), unmapping it from its
+				 *         previous super vertex
+				 *  @details adds the demand of *other* to the load of the vertex, see
+				 *           Graph::set_demand()
+				 */
 				void map(iterator other)
 				{
-					_i->second._add_sub_vertex(&(other._container()));
-					other._container()._set_super_vertex(&(this->_container()));
+					vertex_container<VertexType>& sub = other._container();
+
+					if (sub._super_vertex != nullptr)
+						sub._super_vertex->_remove_sub_vertex(&sub);
+
+					_i->second._add_sub_vertex(&sub, _g->_vertex_demand
+											   ? _g->_vertex_demand(sub._element) : 0);
 				}
 
 				template<typename F>
@@ -366,17 +853,11 @@ namespace plexum
 					f(this->_ptr(), other._ptr());
 				}
 
+				/*! @brief unmaps the vertex *other* from the vertex in O(1) */
 				void unmap(iterator other)
 				{
-					auto sub_it = std::find(
-						_i->second._sub_vertices.begin(),
-						_i->second._sub_vertices.end(),
-						&(other._container())
-					);
-
-					if(sub_it != _i->second._sub_vertices.end()) {
+					if(other._container()._super_vertex == &(_i->second)) {
 						_i->second._remove_sub_vertex(&(other._container()));
-						other._container()._unset_super_vertex();
 					} else {
 						throw exception("Graph::vertex_proxy::iterator::unmap(): "
 											"specified vertex is not a subvertex");
@@ -390,7 +871,6 @@ namespace plexum
 						                " specified vertex does not have a super vertex");
 
 					this->_container()._super_vertex->_remove_sub_vertex(&(this->_container()));
-					this->_container()._unset_super_vertex();
 				}
 
 				template<typename F>
@@ -425,7 +905,21 @@ namespace plexum
 					return v;
 				}
 
-				inline Graph<VertexType, EdgeType>* _graph()
+				/*! @brief returns the number of vertices mapped onto the vertex */
+				inline std::size_t sub_vertex_count()
+				{
+					return _container()._sub_vertices.size();
+				}
+
+				/*! @brief returns the sum of the demands of the vertices mapped onto the vertex,
+				 *         see Graph::set_demand()
+				 */
+				inline double load()
+				{
+					return _container()._load;
+				}
+
+				inline Graph<VertexType, EdgeType, Storage, Direction>* _graph()
 				{
 					return _g;
 				}
@@ -442,32 +936,38 @@ namespace plexum
 
 			private:
 
-				Graph<VertexType, EdgeType>* _g;
+				Graph<VertexType, EdgeType, Storage, Direction>* _g;
 
-				typename std::map<std::size_t, vertex_container<VertexType>>::iterator _i;
+				typename vertex_storage::iterator _i;
 			};
 
 			vertex_proxy() = delete;
 
-			explicit vertex_proxy(Graph<VertexType, EdgeType>* graph)
+			explicit vertex_proxy(Graph<VertexType, EdgeType, Storage, Direction>* graph,
+								  memory_resource* r = new_delete_resource())
 				: _graph(graph),
-				  _i(Graph::ELEMENT_INDEX_INIT),
-				  _vertices()
+				  _vertices(r)
 			{ }
 
 			iterator add(const VertexType& vertex)
 			{
+				_graph->_version++;
+				return iterator(_graph, _vertices.emplace(vertex, _resource()));
+			}
 
-				auto i = iterator(
-					_graph,
-					_vertices.insert(
-						_vertices.end(),
-						std::make_pair(_i, vertex_container<VertexType>(_i, vertex))
-					)
-				);
-
-				_i++;
-				return i;
+			/*! @brief adds a vertex for every value in [first, last)
+			 *  @details reserves storage for all vertices up front. Random access ranges are
+			 *           constructed through the storage's emplace_range(), which splits large
+			 *           ranges across up to *threads* threads (0 selects one per hardware thread)
+			 *           for plexum::slot_storage.
+			 *  @return the ids of the new vertices, in input order
+			 */
+			template<typename InputIt>
+			std::vector<std::size_t> add_range(InputIt first, InputIt last, unsigned threads = 0)
+			{
+				_graph->_version++;
+				return _add_range(first, last, threads,
+								  typename std::iterator_traits<InputIt>::iterator_category());
 			}
 
 			iterator remove(iterator pos)
@@ -476,29 +976,79 @@ namespace plexum
 					throw exception("vertex_proxy::remove(): vertex still has neighbors.");
 				}
 
+				pos._container()._detach();
+				_graph->_version++;
 				return iterator(_graph, _vertices.erase(pos._i));
 			}
 
+			/*! @brief removes the vertex at *pos* together with all its incident edges
+			 *  @details walks the vertex's adjacency lists, removing every edge in O(1), so the
+			 *           removal runs in O(deg(pos)) plus one edge storage lookup per edge. The
+			 *           incoming edges of a plexum::directed graph are only stored by their
+			 *           sources, so if there are any, all adjacency lists are scanned in O(n + m).
+			 *  @return an iterator to the vertex following *pos*
+			 */
 			iterator remove_with_edges(iterator pos)
 			{
-				if(pos.has_neighbors())
-					for(iterator n : pos.neighbors())
-						_graph->edges.remove(_graph->edges.between(pos, n));
+				vertex_container<VertexType>& v = pos._container();
 
+				while (!v._neighbors.empty())
+					_graph->edges._erase(v._neighbors.back().edge);
+
+				_remove_incoming(v, Direction());
+				v._detach();
+				_graph->_version++;
 				return iterator(_graph, _vertices.erase(pos._i));
 			}
 
-			bool has_index(std::size_t index)
+			/*! @brief removes all vertices in *batch* together with their incident edges
+			 *  @details runs in O(sum of the degrees of the removed vertices and their remaining
+			 *           neighbors): every edge is removed from storage once, and the adjacency list
+			 *           of every remaining neighbor is compacted in a single pass that preserves the
+			 *           order of its other entries. Duplicates in *batch* are ignored. For
+			 *           plexum::directed graphs, edges from remaining vertices into removed ones
+			 *           are found by scanning all adjacency lists in O(n + m).
+			 */
+			void remove_with_edges(const std::vector<iterator>& batch)
 			{
-				return _vertices.find(index) != _vertices.end();
-			}
+				search_workspace& ws = _graph->_workspace;
+				std::vector<vertex_container<VertexType>*> doomed;
 
-			iterator operator[](std::size_t index) throw(exception)
-			{
-				auto i = _vertices.find(index);
+				// removed vertices are marked without a parent edge, their remaining neighbors
+				// with the edge they were found through
+				ws._reset(_vertices.bound());
 
-				if (i != _vertices.end())
-					return iterator(_graph, _vertices.find(index));
+				for (iterator v : batch) {
+					std::size_t i = vertex_storage::index(v.id());
+
+					if (!ws._is_visited(i)) {
+						ws._visit(i, nullptr);
+						doomed.push_back(&v._container());
+					}
+				}
+
+				_remove_batch(doomed, ws, Direction());
+
+				for (vertex_container<VertexType>* v : doomed) {
+					v->_detach();
+					_vertices.erase(_vertices.find(v->_id));
+				}
+
+				_graph->_components_stale = true;
+				_graph->_shrunk();
+			}
+
+			bool has_index(std::size_t index)
+			{
+				return _vertices.find(index) != _vertices.end();
+			}
+
+			iterator operator[](std::size_t index) throw(exception)
+			{
+				auto i = _vertices.find(index);
+
+				if (i != _vertices.end())
+					return iterator(_graph, _vertices.find(index));
 				else
 					throw exception("vertex_proxy::operator[]: index "
 									+ std::to_string(index) + " does not exist.");
@@ -521,31 +1071,191 @@ namespace plexum
 
 		private:
 
-			void _add_neighbor(iterator neighbor, iterator vertex) // invoked from edge_proxy
+			inline memory_resource* _resource()
+			{
+				return _graph->_resource;
+			}
+
+			template<typename It>
+			std::vector<std::size_t> _add_range(It first, It last, unsigned threads,
+												std::random_access_iterator_tag)
+			{
+				std::vector<std::size_t> ids(static_cast<std::size_t>(last - first));
+
+				_vertices.emplace_range(ids.size(), threads,
+					[first](std::size_t i) -> VertexType { return first[i]; },
+					[&ids](std::size_t i, typename vertex_storage::value_type& p) {
+						ids[i] = p.first;
+					},
+					_resource());
+
+				return ids;
+			}
+
+			template<typename It>
+			std::vector<std::size_t> _add_range(It first, It last, unsigned,
+												std::forward_iterator_tag)
+			{
+				_vertices.reserve(static_cast<std::size_t>(std::distance(first, last)));
+				return _add_range(first, last, 0, std::input_iterator_tag());
+			}
+
+			template<typename It>
+			std::vector<std::size_t> _add_range(It first, It last, unsigned, std::input_iterator_tag)
+			{
+				std::vector<std::size_t> ids;
+
+				for (; first != last; ++first)
+					ids.push_back(_vertices.emplace(*first, _resource())->first);
+
+				return ids;
+			}
+
+			// the incoming edges of undirected graphs are in the incidence list
+			void _remove_incoming(vertex_container<VertexType>&, undirected)
+			{ }
+
+			void _remove_incoming(vertex_container<VertexType>& v, bidirectional)
+			{
+				while (!v._in_neighbors.empty())
+					_graph->edges._erase(v._in_neighbors.back().edge);
+			}
+
+			// incoming edges are only known to their sources, so the scan stops once all are found
+			void _remove_incoming(vertex_container<VertexType>& v, directed)
+			{
+				for (auto p = _vertices.begin(); p != _vertices.end() && v._in_degree != 0; ++p) {
+					_adjacency_list& l = p->second._neighbors;
+
+					for (std::size_t k = 0; k < l.size(); ) {
+						if (l[k].vertex == &v)
+							_graph->edges._erase(l[k].edge);
+						else
+							k++;
+					}
+				}
+			}
+
+			static bool _is_doomed(vertex_container<VertexType>* v, search_workspace& ws)
+			{
+				std::size_t i = vertex_storage::index(v->_id);
+				return ws._is_visited(i) && ws._parent[i] == nullptr;
+			}
+
+			// erases the edges of the entries in *l* of a removed vertex and marks the remaining
+			// neighbors as *affected*
+			void _erase_entries(_adjacency_list& l, search_workspace& ws,
+								std::vector<vertex_container<VertexType>*>& affected)
+			{
+				for (auto& a : l) {
+					std::size_t i = vertex_storage::index(a.vertex->_id);
+
+					// an edge between two removed vertices is erased through its first entry,
+					// its second entry may already point to a destroyed edge
+					if (_is_doomed(a.vertex, ws)) {
+						if (a.side == 1)
+							continue;
+					} else if (!ws._is_visited(i)) {
+						ws._visit(i, a.edge);
+						affected.push_back(a.vertex);
+					}
+
+					_erase_edge(a.edge);
+				}
+			}
+
+			// removes an edge of the batch from storage, the adjacency lists are compacted later
+			void _erase_edge(edge_container<EdgeType>* e)
+			{
+				e->_detach();
+				_graph->edges._edges.erase(_graph->edges._edges.find(e->_id));
+			}
+
+			// drops the entries of *l* leading to removed vertices
+			static void _compact(_adjacency_list& l, search_workspace& ws)
+			{
+				std::size_t n = 0;
+
+				for (auto& a : l) {
+					if (!_is_doomed(a.vertex, ws)) {
+						a.edge->_position[a.side] = n;
+						l[n++] = a;
+					}
+				}
+
+				l.resize(n);
+			}
+
+			template<class D>
+			void _remove_batch(const std::vector<vertex_container<VertexType>*>& doomed,
+							   search_workspace& ws, D)
 			{
-				vertex._container()._add_neighbor(&neighbor._container());
+				std::vector<vertex_container<VertexType>*> affected;
+
+				for (vertex_container<VertexType>* v : doomed) {
+					_erase_entries(v->_neighbors, ws, affected);
+
+					if (D::in_edges)
+						_erase_entries(_graph->_incoming(v, D()), ws, affected);
+				}
+
+				for (vertex_container<VertexType>* v : affected) {
+					_compact(v->_neighbors, ws);
+
+					if (D::in_edges)
+						_compact(_graph->_incoming(v, D()), ws);
+				}
 			}
 
-			Graph<VertexType, EdgeType>* _graph;
+			void _remove_batch(const std::vector<vertex_container<VertexType>*>& doomed,
+							   search_workspace& ws, directed)
+			{
+				std::size_t incoming = 0;
+
+				for (vertex_container<VertexType>* v : doomed) {
+					for (auto& a : v->_neighbors) {
+						a.vertex->_in_degree--;
+						_erase_edge(a.edge);
+					}
+				}
+
+				for (vertex_container<VertexType>* v : doomed)
+					incoming += v->_in_degree;
+
+				// the remaining incoming edges are only known to their sources
+				for (auto p = _vertices.begin(); p != _vertices.end() && incoming != 0; ++p) {
+					if (_is_doomed(&p->second, ws))
+						continue;
+
+					for (auto& a : p->second._neighbors) {
+						if (_is_doomed(a.vertex, ws)) {
+							_erase_edge(a.edge);
+							incoming--;
+						}
+					}
+
+					_compact(p->second._neighbors, ws);
+				}
+			}
 
-			std::size_t _i;
+			Graph<VertexType, EdgeType, Storage, Direction>* _graph;
 
-			std::map<std::size_t, vertex_container<VertexType>> _vertices;
+			vertex_storage _vertices;
 		};
 
 		//
-		// plexum::Graph<VertexType, EdgeType>::edge_proxy
+		// plexum::Graph<VertexType, EdgeType, Storage, Direction>::edge_proxy
 		//
 
 		class edge_proxy
 		{
-			friend class Graph<VertexType, EdgeType>;
+			friend class Graph<VertexType, EdgeType, Storage, Direction>;
 			friend class vertex_proxy;
 
 		public:
 
 			//
-			// plexum::Graph<VertexType, EdgeType>::edge_proxy::iterator
+			// plexum::Graph<VertexType, EdgeType, Storage, Direction>::edge_proxy::iterator
 			//
 
 			class iterator
@@ -558,8 +1268,8 @@ namespace plexum
 				iterator() = delete;
 
 				inline iterator(
-					Graph<VertexType, EdgeType>* g,
-					typename std::map<std::size_t, edge_container<EdgeType>>::iterator i
+					Graph<VertexType, EdgeType, Storage, Direction>* g,
+					typename edge_storage::iterator i
 				)
 					: _g(g),
 					  _i(i)
@@ -605,10 +1315,15 @@ namespace plexum
 					return _i->first;
 				}
 
+				/*! @brief maps the edge *other* onto the edge, replacing the super edges of
+				 *         *other*
+				 *  @details adds the demand of *other* to the load of the edge, see
+				 *           Graph::set_demand()
+				 */
 				void map_link(iterator other)
 				{
-					_i->second._add_sub_edge(&(other._container()));
-					other._container()._set_super_edge(&(this->_container()));
+					other._container()._clear_super_edges();
+					map_path(other);
 				}
 
 				template<typename F>
@@ -618,10 +1333,15 @@ namespace plexum
 					f(this->_ptr(), other._ptr());
 				}
 
+				/*! @brief appends the edge to the super edges of *other*, which form a path
+				 *  @details adds the demand of *other* to the load of the edge in O(1)
+				 */
 				void map_path(iterator other)
 				{
-					_i->second._add_sub_edge(&(other._container()));
-					other._container()._add_super_edge(&(this->_container()));
+					edge_container<EdgeType>& sub = other._container();
+
+					_i->second._add_sub_edge(&sub, _g->_edge_demand
+											 ? _g->_edge_demand(sub._element) : 0);
 				}
 
 				template<typename F>
@@ -631,17 +1351,17 @@ namespace plexum
 					f(this->_ptr(), other._ptr());
 				}
 
+				/*! @brief unmaps the edge *other* from the edge
+				 *  @details takes time linear in the number of super edges of *other*, but
+				 *           independent of the number of sub edges of the edge. Other super
+				 *           edges of *other* remain mapped.
+				 */
 				void unmap(iterator other)
 				{
-					auto sub_it = std::find(
-						_i->second._sub_edges.begin(),
-						_i->second._sub_edges.end(),
-						&(other._container())
-					);
+					std::size_t i = other._container()._find_super_edge(&(_i->second));
 
-					if(sub_it != _i->second._sub_edges.end()) {
-						_i->second._remove_sub_edge(&(other._container()));
-						other._container()._unset_super_edge();
+					if(i != static_cast<std::size_t>(-1)) {
+						other._container()._remove_super_edge(i);
 					} else {
 						throw exception("Graph::edge_proxy::iterator::unmap(): "
 											"specified edge is not a subedge");
@@ -657,10 +1377,7 @@ namespace plexum
 
 				void unmap_from_super_edge()
 				{
-					for( auto c : this->_container()._super_edge) {
-						c->_remove_sub_edge(&(this->_container()));
-						this->_container()._unset_super_edge();
-					}
+					this->_container()._clear_super_edges();
 				}
 
 				bool has_subedges()
@@ -678,7 +1395,7 @@ namespace plexum
 					std::vector<EdgeType*> v;
 
 					for(auto c : _container()._super_edge)
-						v.push_back(&(c->_element));
+						v.push_back(&(c.edge->_element));
 
 					return v;
 				}
@@ -688,11 +1405,25 @@ namespace plexum
 					std::vector<EdgeType*> v;
 
 					for(auto c : _container()._sub_edges)
-						v.push_back(&(c->_element));
+						v.push_back(&(c.edge->_element));
 
 					return v;
 				}
 
+				/*! @brief returns the number of edges mapped onto the edge */
+				inline std::size_t sub_edge_count()
+				{
+					return _container()._sub_edges.size();
+				}
+
+				/*! @brief returns the sum of the demands of the edges mapped onto the edge, see
+				 *         Graph::set_demand()
+				 */
+				inline double load()
+				{
+					return _container()._load;
+				}
+
 				inline typename vertex_proxy::iterator from()
 				{
 					return _g->vertices[_container()._from->_id];
@@ -703,7 +1434,7 @@ namespace plexum
 					return _g->vertices[_container()._to->_id];
 				}
 
-				inline Graph<VertexType, EdgeType>* _graph()
+				inline Graph<VertexType, EdgeType, Storage, Direction>* _graph()
 				{
 					return _g;
 				}
@@ -720,17 +1451,17 @@ namespace plexum
 
 			private:
 
-				Graph<VertexType, EdgeType>* _g;
+				Graph<VertexType, EdgeType, Storage, Direction>* _g;
 
-				typename std::map<std::size_t, edge_container<EdgeType>>::iterator _i;
+				typename edge_storage::iterator _i;
 			};
 
 			edge_proxy() = delete;
 
-			edge_proxy(Graph<VertexType, EdgeType>* graph)
+			edge_proxy(Graph<VertexType, EdgeType, Storage, Direction>* graph,
+					   memory_resource* r = new_delete_resource())
 				: _graph(graph),
-				  _i(Graph::ELEMENT_INDEX_INIT),
-				  _edges()
+				  _edges(r)
 			{ }
 
 			iterator add(
@@ -738,25 +1469,172 @@ namespace plexum
 				typename vertex_proxy::iterator to,
 				const EdgeType& edge)
 			{
-				auto i = iterator(
-					_graph,
-					_edges.insert(
-						_edges.end(),
-						std::make_pair(_i, edge_container<EdgeType>(_i, edge))
-					)
-				);
+				auto i = iterator(_graph, _edges.emplace(edge, _graph->_resource));
 
 				_connect(from, to, i);
-				_set_neighbors_bidirectional(from, to);
-				_set_edges_bidirectional(from, to, i);
-				_i++;
+				_link(&i._container());
+				_graph->_join(&from._container(), &to._container());
+				_graph->_grown();
 				return i;
 			}
 
+			/*! @brief adds an edge for every (from id, to id, value) tuple in [first, last)
+			 *  @details Builds the adjacency in passes instead of edge by edge. First it
+			 *           resolves all endpoints, then it counts how many entries each list gains
+			 *           while assigning each edge its positions, and grows every adjacency list
+			 *           once. Finally it constructs the edges through the storage's
+			 *           emplace_range() and fills their entries in the same pass, which is split
+			 *           across up to *threads* threads (0 selects one per hardware thread) for
+			 *           large random access ranges in plexum::slot_storage. Resolving the
+			 *           endpoints of a random access range runs on the same threads. Counting and
+			 *           growing the lists stay on the calling thread, so the adjacency order does
+			 *           not depend on the number of threads.
+			 *           The tuples are read through std::get<0>, std::get<1> and std::get<2>.
+			 *           Ranges with at least as many edges as the graph has vertices resolve their
+			 *           endpoints through a dense table instead of storage lookups. Smaller ranges
+			 *           are inserted edge by edge after all endpoints have been resolved, so the cost
+			 *           of a call never depends on the size of the graph.
+			 *           If constructing an edge throws, the edges added so far are removed again and
+			 *           the exception is rethrown, so the graph is left unchanged.
+			 *  @throws exception if an endpoint does not exist, in which case no edge is added
+			 */
+			template<typename ForwardIt>
+			void add_range(ForwardIt first, ForwardIt last, unsigned threads = 0)
+			{
+				typedef vertex_container<VertexType> vc;
+				typedef typename std::iterator_traits<ForwardIt>::iterator_category category;
+
+				auto& vs = _graph->vertices._vertices;
+				std::size_t m = static_cast<std::size_t>(std::distance(first, last));
+				std::vector<_bulk_edge> ends(m);
+				std::vector<vc*> table;
+
+				if (m >= vs.size()) {
+					table.assign(vs.bound(), nullptr);
+
+					for (auto& p : vs)
+						table[vertex_storage::index(p.first)] = &p.second;
+				}
+
+				// only reads the storage, so it may run on several threads
+				auto resolve = [&](std::size_t id) -> vc* {
+					if (table.empty()) {
+						auto i = vs.find(id);
+						return i == vs.end() ? nullptr : &i->second;
+					}
+
+					std::size_t i = vertex_storage::index(id);
+					return i < table.size() && table[i] != nullptr && table[i]->_id == id ? table[i]
+																						 : nullptr;
+				};
+
+				_resolve(first, ends, threads, resolve, category());
+
+				ForwardIt t = first;
+
+				for (std::size_t i = 0; i < m; ++i, ++t)
+					if (ends[i].from == nullptr || ends[i].to == nullptr)
+						throw exception("edge_proxy::add_range(): vertex "
+										+ std::to_string(ends[i].from == nullptr ? std::get<0>(*t)
+																				 : std::get<1>(*t))
+										+ " does not exist.");
+
+				if (table.empty()) {
+					std::vector<std::size_t> added;
+
+					added.reserve(m);
+					_edges.reserve(m);
+
+					// whether the last edge in *added* has its entries, _link() adds both or none
+					bool linked = true;
+
+					try {
+						for (std::size_t i = 0; first != last; ++first, ++i) {
+							auto p = _edges.emplace(std::get<2>(*first), _graph->_resource);
+							edge_container<EdgeType>* e = &p->second;
+
+							added.push_back(p->first);
+							linked = false;
+							e->_set_from(ends[i].from);
+							e->_set_to(ends[i].to);
+							_link(e);
+							linked = true;
+						}
+					} catch (...) {
+						// the last edge is unlinked first, so every entry is at the end of its list
+						for (auto i = added.rbegin(); i != added.rend(); ++i) {
+							auto p = _edges.find(*i);
+
+							if (i != added.rbegin() || linked)
+								_unlink(&p->second);
+
+							_edges.erase(p);
+						}
+
+						throw;
+					}
+
+					for (auto& b : ends)
+						_graph->_join(b.from, b.to);
+
+					_graph->_grown();
+					return;
+				}
+
+				std::vector<std::size_t> cursor(Direction::in_edges ? 2 * vs.bound() : vs.bound(), 0);
+				_touched_lists touched;
+
+				// each edge is given its positions relative to the old end of its lists
+				for (auto& b : ends) {
+					b.position[0] = _count(b.from->_neighbors, _cursor(b.from, 0), cursor, touched);
+					_count_target(b, cursor, touched, Direction());
+				}
+
+				std::size_t grown = 0;
+
+				try {
+					// grow every list once, the cursors then hold the old ends
+					for (; grown < touched.size(); grown++) {
+						std::size_t& c = cursor[touched[grown].second];
+						std::size_t n = touched[grown].first->size();
+						touched[grown].first->resize(n + c);
+						c = n;
+					}
+
+					// every entry has its own position, so threads never write the same element
+					_emplace(first, m, threads,
+						[&ends, &cursor](std::size_t i, typename edge_storage::value_type& p) {
+							edge_container<EdgeType>* e = &p.second;
+							const _bulk_edge& b = ends[i];
+
+							e->_set_from(b.from);
+							e->_set_to(b.to);
+							e->_position[0] = cursor[_cursor(b.from, 0)] + b.position[0];
+							b.from->_neighbors[e->_position[0]] = {b.to, e, 0};
+							_fill_target(e, b, cursor, Direction());
+						}, category());
+				} catch (...) {
+					// the storage has destroyed the new edges, their entries are cut off again
+					for (std::size_t i = 0; i < grown; i++)
+						touched[i].first->resize(cursor[touched[i].second]);
+
+					throw;
+				}
+
+				for (auto& b : ends) {
+					_add_in_degree(b, Direction());
+					_graph->_join(b.from, b.to);
+				}
+
+				_graph->_grown();
+			}
+
 			iterator remove(iterator edge_it)
 			{
-				_unset_neighbors_bidirectional(edge_it);
-				_unset_edges_bidirectional(edge_it);
+				_unlink(&edge_it._container());
+				edge_it._container()._detach();
+				_graph->_components_stale = true;
+				_graph->_shrunk();
 				return iterator(_graph, _edges.erase(edge_it._i));
 			}
 
@@ -791,21 +1669,26 @@ namespace plexum
 				return _edges.size();
 			}
 
+			/*! @brief returns an iterator to the edge connecting *from* and *to*, which must be
+			 *         the edge's source and target in directed graphs
+			 *  @details only the shorter adjacency list that holds the edge is scanned, so the
+			 *           lookup runs in O(min(deg(from), deg(to))) for undirected graphs, in
+			 *           O(min(out-deg(from), in-deg(to))) for plexum::bidirectional graphs and in
+			 *           O(out-deg(from)) for plexum::directed graphs. If there are parallel edges,
+			 *           any one of them is returned.
+			 *  @throws exception if there is no edge between *from* and *to*
+			 */
 			iterator between(typename vertex_proxy::iterator from,
 							 typename vertex_proxy::iterator to)
 				throw(exception)
 			{
-				for (typename edge_proxy::iterator i = _graph->edges.begin(); i != _graph->edges.end(); ++i)
-				{
-					bool from_match_1 = i.from().id() == from.id();
-					bool to_match_1   = i.to().id()   == to.id();
-					bool from_match_2 = i.to().id()   == from.id();
-					bool to_match_2   = i.from().id() == to.id();
+				edge_container<EdgeType>* e = _between(&from._container(), &to._container(),
+													   Direction());
 
-					if((from_match_1 && to_match_1) || (from_match_2 && to_match_2))
-						return i;
-				}
-				throw exception("edge_proxy::between(a, b): there is no edge between a and b");
+				if (e == nullptr)
+					throw exception("edge_proxy::between(a, b): there is no edge between a and b");
+
+				return iterator(_graph, _edges.find(e->_id));
 			}
 
 		private:
@@ -819,218 +1702,2486 @@ namespace plexum
 				edge._container()._set_to(&to._container());
 			}
 
-			void _set_neighbors_bidirectional(
-				typename vertex_proxy::iterator from,
-				typename vertex_proxy::iterator to)
+			// the endpoints of an edge added by add_range() and its positions among the entries
+			// their lists gain
+			struct _bulk_edge
+			{
+				vertex_container<VertexType>* from;
+				vertex_container<VertexType>* to;
+				std::size_t position[2];
+			};
+
+			// the lists add_range() grows, each with the index of its cursor
+			typedef std::vector<std::pair<_adjacency_list*, std::size_t>> _touched_lists;
+
+			// the index of the add_range() cursor of the list holding the entries of *side* at
+			// *v*, one per vertex unless the graph keeps separate in-adjacency lists
+			static std::size_t _cursor(vertex_container<VertexType>* v, unsigned side)
 			{
-				_graph->vertices._add_neighbor(from, to);
-				_graph->vertices._add_neighbor(to, from);
+				std::size_t i = vertex_storage::index(v->_id);
+				return Direction::in_edges ? 2 * i + side : i;
 			}
 
-			void _unset_neighbors_bidirectional(iterator edge)
+			template<typename It, typename R>
+			static void _resolve(It first, std::vector<_bulk_edge>& ends, unsigned threads,
+								 R resolve, std::random_access_iterator_tag)
 			{
-				edge._container()._from->_remove_neighbor(edge._container()._to);
-				edge._container()._to->_remove_neighbor(edge._container()._from);
+				parallel_for(0, ends.size(), threads, PARALLEL_GRAIN,
+					[&](std::size_t begin, std::size_t end, unsigned) {
+						for (std::size_t i = begin; i < end; i++) {
+							ends[i].from = resolve(std::get<0>(first[i]));
+							ends[i].to = resolve(std::get<1>(first[i]));
+						}
+					});
 			}
 
-			void _set_edges_bidirectional(
-				typename vertex_proxy::iterator from,
-				typename vertex_proxy::iterator to,
-				iterator edge)
+			template<typename It, typename R>
+			static void _resolve(It first, std::vector<_bulk_edge>& ends, unsigned, R resolve,
+								 std::forward_iterator_tag)
 			{
-				from._container()._add_out_edge(&edge._container());
-				to._container()._add_in_edge(&edge._container());
-				to._container()._add_out_edge(&edge._container());
-				from._container()._add_in_edge(&edge._container());
+				for (auto& b : ends) {
+					b.from = resolve(std::get<0>(*first));
+					b.to = resolve(std::get<1>(*first));
+					++first;
+				}
 			}
 
-			void _unset_edges_bidirectional(iterator edge)
+			template<typename It, typename F>
+			void _emplace(It first, std::size_t m, unsigned threads, F visit,
+						  std::random_access_iterator_tag)
 			{
-				edge._container()._from->_remove_in_edge(&edge._container());
-				edge._container()._to->_remove_in_edge(&edge._container());
-				edge._container()._from->_remove_out_edge(&edge._container());
-				edge._container()._to->_remove_out_edge(&edge._container());
+				_edges.emplace_range(m, threads,
+					[first](std::size_t i) -> EdgeType { return std::get<2>(first[i]); },
+					visit, _graph->_resource);
 			}
 
-			Graph<VertexType, EdgeType>* _graph;
-			std::size_t _i;
-			std::map<std::size_t, edge_container<EdgeType>> _edges;
-		};
+			// the values are read in input order, so they are constructed on a single thread
+			template<typename It, typename F>
+			void _emplace(It first, std::size_t m, unsigned, F visit, std::forward_iterator_tag)
+			{
+				_edges.emplace_range(m, 1,
+					[&first](std::size_t) -> EdgeType { return std::get<2>(*first++); },
+					visit, _graph->_resource);
+			}
 
-	public:
+			// counts an entry of the list *l* with cursor *c*, returns its position among the
+			// entries *l* gains
+			static std::size_t _count(_adjacency_list& l, std::size_t c, std::vector<std::size_t>& cursor,
+									  _touched_lists& touched)
+			{
+				std::size_t k = cursor[c]++;
 
-		/*! @brief constructs a new Graph object */
-		Graph()
-			: vertices(this),
-			  edges(this),
-			  _supergraph(nullptr),
-			  _subgraphs()
-		{ }
+				if (k == 0)
+					touched.push_back(std::make_pair(&l, c));
 
-		/*! @brief maps the graph *subgraph* onto the graph
-		 *  @param subgraph the subgraph to be mapped
-		 */
-		void map(Graph<VertexType, EdgeType>* subgraph)
-		{
-			_subgraphs.push_back(subgraph);
-			subgraph->_supergraph = this;
-		}
+				return k;
+			}
 
-		/*! @brief checks if *subgraph* is mapped onto the graph
- 		 *  @param subgraph the subgraph to be checked
- 		 *  @return true if *subgraph* is mapped, false otherwise
- 		 */
-		bool has_subgraph(Graph<VertexType, EdgeType>* subgraph) const
-		{
-			return std::find(_subgraphs.begin(), _subgraphs.end(), subgraph) != _subgraphs.end();
-		}
+			template<class D>
+			static void _count_target(_bulk_edge& b, std::vector<std::size_t>& cursor,
+									  _touched_lists& touched, D)
+			{
+				b.position[1] = _count(_incoming(b.to, D()), _cursor(b.to, 1), cursor, touched);
+			}
 
-		/*! @brief checks whether the graph has any subgraphs mapped
-	  	 *  @return true if there are mapped subgraphs, false otherwise
-	  	 */
-		bool has_subgraphs() const
-		{
-			return !_subgraphs.empty();
-		}
+			static void _count_target(_bulk_edge& b, std::vector<std::size_t>&, _touched_lists&,
+									  directed)
+			{
+				b.position[1] = 0;
+			}
 
-		/*! @brief unmaps *subgraph* from the graph
-   		 *  @param subgraph the subgraph to be unmapped
-   		 */
-		void unmap(Graph<VertexType, EdgeType>* subgraph)
-		{
-			auto subgraph_it = std::find(_subgraphs.begin(), _subgraphs.end(), subgraph);
+			// directed targets keep no incoming list, only their in-degree, which is raised once
+			// the edges exist
+			template<class D>
+			static void _add_in_degree(const _bulk_edge&, D)
+			{ }
 
-			if(subgraph_it != _subgraphs.end()) {
-				_subgraphs.erase(subgraph_it);
-				subgraph->_supergraph = nullptr;
-			} else {
-				throw exception("Graph::unmap(): specified graph is not a subgraph");
+			static void _add_in_degree(const _bulk_edge& b, directed)
+			{
+				b.to->_in_degree++;
 			}
-		}
 
-		/*! @brief returns a pointer to the graph's super-graph
-		 *  @return a pointer to the super-graph or std::nullptr if there is no super-graph
-		 */
-		const Graph<VertexType, EdgeType>* supergraph()
-		{
-			return _supergraph;
-		};
+			template<class D>
+			static void _fill_target(edge_container<EdgeType>* e, const _bulk_edge& b,
+									 const std::vector<std::size_t>& cursor, D)
+			{
+				e->_position[1] = cursor[_cursor(b.to, 1)] + b.position[1];
+				_incoming(e->_to, D())[e->_position[1]] = {e->_from, e, 1};
+			}
 
-		/*! @brief  returns a reference to a std::vector containing pointers
-		 * 		    to the graph's sub-graphs
- 		 *  @return a reference to a std::vector containing pointers to the graph's sub-graph or
- 		 *  		a reference to an empty std::vector if there are no sub-graphs
- 		 */
-		const std::vector<Graph<VertexType, EdgeType>*>& subgraphs()
-		{
-			return _subgraphs;
-		};
+			static void _fill_target(edge_container<EdgeType>*, const _bulk_edge&,
+									 const std::vector<std::size_t>&, directed)
+			{ }
 
-		std::vector<typename edge_proxy::iterator> find_path(typename vertex_proxy::iterator start,
-															 typename vertex_proxy::iterator target)
-		{
-			return find_path(start, target, [](EdgeType*) { return true; });
-		}
+			// adds the entries of *e* to the adjacency lists of its endpoints, both lists are
+			// grown first, so either both entries are added or none
+			static void _link(edge_container<EdgeType>* e)
+			{
+				_reserve_entries(e, Direction());
+				vertex_container<VertexType>::_add_entry(e->_from->_neighbors, e->_to, e, 0);
+				_link_target(e, Direction());
+			}
 
-		template<typename F>
-		std::vector<typename edge_proxy::iterator> find_path(typename vertex_proxy::iterator start,
-															 typename vertex_proxy::iterator target,
-															 F cstr)
-			throw(exception)
-		{
-			std::vector<typename edge_proxy::iterator> path;
-			std::map<unsigned long, long> bfs_tree = _bfs_adjacency(start.id(), target.id(), cstr);
+			template<class D>
+			static void _reserve_entries(edge_container<EdgeType>* e, D)
+			{
+				_adjacency_list& out = e->_from->_neighbors;
+				_adjacency_list& in = _incoming(e->_to, D());
+
+				if (&out == &in) {
+					_reserve_entries(out, 2);
+				} else {
+					_reserve_entries(out, 1);
+					_reserve_entries(in, 1);
+				}
+			}
 
-			unsigned long v = target.id();
+			static void _reserve_entries(edge_container<EdgeType>* e, directed)
+			{
+				_reserve_entries(e->_from->_neighbors, 1);
+			}
 
-			if (bfs_tree[v] < 0)
-				throw exception("there is no path between the specified vertices");
+			// makes room for *k* more entries in *l*, keeping the geometric growth of push_back()
+			static void _reserve_entries(_adjacency_list& l, std::size_t k)
+			{
+				if (l.size() + k > l.capacity())
+					l.reserve(std::max(l.size() + k, 2 * l.capacity()));
+			}
 
-			while (v != start.id()) {
-				auto a = vertices[v];
-				v = bfs_tree[v];
-				auto b = vertices[v];
-				path.push_back(edges.between(a, b));
+			template<class D>
+			static void _link_target(edge_container<EdgeType>* e, D)
+			{
+				vertex_container<VertexType>::_add_entry(_incoming(e->_to, D()), e->_from, e, 1);
 			}
 
-			std::reverse(path.begin(), path.end());
-			return path;
-		}
+			static void _link_target(edge_container<EdgeType>* e, directed)
+			{
+				e->_to->_in_degree++;
+			}
 
-		template<class T, class U> // T, U in order not to shadow VertexType, EdgeType
-		friend std::ostream& operator<<(std::ostream& os, Graph<T, U>& g);
+			// the edge's positions are looked up again after the first removal, which may have
+			// moved its second entry if both are in the same list (self-loops)
+			static void _unlink(edge_container<EdgeType>* e)
+			{
+				vertex_container<VertexType>::_remove_entry(e->_from->_neighbors, e->_position[0]);
+				_unlink_target(e, Direction());
+			}
 
-		/*! @brief the vertex_proxy holding the graph's vertices */
-		vertex_proxy vertices;
+			template<class D>
+			static void _unlink_target(edge_container<EdgeType>* e, D)
+			{
+				vertex_container<VertexType>::_remove_entry(_incoming(e->_to, D()), e->_position[1]);
+			}
 
-		/*! @brief the edge_proxy holding the graph's edges */
-		edge_proxy edges;
+			static void _unlink_target(edge_container<EdgeType>* e, directed)
+			{
+				e->_to->_in_degree--;
+			}
 
-	private:
+			// removes the edge *e* from the adjacency lists and the storage
+			void _erase(edge_container<EdgeType>* e)
+			{
+				remove(iterator(_graph, _edges.find(e->_id)));
+			}
 
-		template<typename F>
-		const std::map<unsigned long, long>
-			_bfs_adjacency(unsigned long start, unsigned long target,
-						   F cstr)
-		{
-			unsigned long c = 0;
-			auto s = this->vertices[start];
-			std::map<unsigned long, long> visited;
-			std::list<unsigned long> queue;
+			// the edge of an entry in *l* leading to *v*, or nullptr if there is none
+			static edge_container<EdgeType>* _scan(const _adjacency_list& l,
+												   vertex_container<VertexType>* v)
+			{
+				for (auto& a : l)
+					if (a.vertex == v)
+						return a.edge;
 
-			for (auto i = vertices.begin(); i != vertices.end(); i++)
-				visited[i.id()] = -1;
+				return nullptr;
+			}
 
-			visited[s.id()] = start;
-			queue.push_back(s.id());
+			static edge_container<EdgeType>* _between(vertex_container<VertexType>* a,
+													  vertex_container<VertexType>* b, undirected)
+			{
+				return b->_neighbors.size() < a->_neighbors.size() ? _scan(b->_neighbors, a)
+																   : _scan(a->_neighbors, b);
+			}
 
-			while (!queue.empty()) {
-				c = queue.front();
-				queue.pop_front();
+			static edge_container<EdgeType>* _between(vertex_container<VertexType>* a,
+													  vertex_container<VertexType>* b, directed)
+			{
+				return _scan(a->_neighbors, b);
+			}
 
-				auto c_iter = vertices[c];
+			static edge_container<EdgeType>* _between(vertex_container<VertexType>* a,
+													  vertex_container<VertexType>* b, bidirectional)
+			{
+				return b->_in_neighbors.size() < a->_neighbors.size() ? _scan(b->_in_neighbors, a)
+																	  : _scan(a->_neighbors, b);
+			}
+
+			Graph<VertexType, EdgeType, Storage, Direction>* _graph;
+			edge_storage _edges;
+		};
+
+		//
+		// plexum::Graph<VertexType, EdgeType, Storage, Direction>::search_workspace
+		//
+
+		/*! @brief Reusable scratch space for graph searches.
+		 *  @details Holds the visited marks, parent edges and frontier of a search in dense arrays
+		 *           indexed by vertex storage index. The arrays only grow, and visited marks are
+		 *           invalidated by bumping an epoch counter instead of clearing them, so repeated
+		 *           searches on a workspace do not allocate once it has reached the graph's size.
+		 *           Weighted searches additionally keep tentative distances and a priority queue.
+		 *           A workspace must not be shared by concurrently running searches.
+		 */
+		class search_workspace
+		{
+			friend class Graph<VertexType, EdgeType, Storage, Direction>;
+
+		public:
+
+			search_workspace()
+				: _epoch(0),
+				  _expanded(0),
+				  _visited(),
+				  _parent(),
+				  _frontier(),
+				  _distance(),
+				  _vertex(),
+				  _heap(),
+				  _stack(),
+				  _reverse()
+			{ }
+
+			// scratch space is not state, so copies start out empty
+			search_workspace(const search_workspace&)
+				: search_workspace()
+			{ }
+
+			search_workspace& operator=(const search_workspace&)
+			{
+				return *this;
+			}
+
+			/*! @brief returns the number of vertices expanded by the last search on the workspace */
+			std::size_t expanded() const
+			{
+				return _expanded + (_reverse ? _reverse->_expanded : 0);
+			}
+
+		private:
+
+			// prepares the workspace for a new search on a graph with the given vertex bound
+			void _reset(std::size_t bound)
+			{
+				_expanded = 0;
+
+				if (_reverse)
+					_reverse->_expanded = 0;
+
+				if (_visited.size() < bound) {
+					_visited.resize(bound, 0);
+					_parent.resize(bound, nullptr);
+					_frontier.resize(bound, nullptr);
+				}
+
+				if (++_epoch == 0) {
+					std::fill(_visited.begin(), _visited.end(), 0);
+					_epoch = 1;
+				}
+			}
+
+			// prepares the workspace for a new weighted search
+			void _reset_weighted(std::size_t bound)
+			{
+				_reset(bound);
+
+				if (_distance.size() < bound) {
+					_distance.resize(bound, 0);
+					_vertex.resize(bound, nullptr);
+				}
+
+				_heap.reset(bound);
+			}
+
+			inline bool _is_visited(std::size_t i) const
+			{
+				return _visited[i] == _epoch;
+			}
+
+			inline void _visit(std::size_t i, edge_container<EdgeType>* parent)
+			{
+				_visited[i] = _epoch;
+				_parent[i] = parent;
+			}
+
+			// the workspace of the backward half of bidirectional searches
+			search_workspace& _backward()
+			{
+				if (!_reverse)
+					_reverse.reset(new search_workspace());
+
+				return *_reverse;
+			}
+
+			std::uint32_t _epoch;
+			std::size_t _expanded;
+			std::vector<std::uint32_t> _visited;
+			std::vector<edge_container<EdgeType>*> _parent;
+			std::vector<vertex_container<VertexType>*> _frontier;
+			std::vector<double> _distance;
+			std::vector<vertex_container<VertexType>*> _vertex;
+			indexed_heap<double> _heap;
+			std::vector<std::pair<vertex_container<VertexType>*, std::size_t>> _stack;
+			std::unique_ptr<search_workspace> _reverse;
+		};
+
+		//
+		// plexum::Graph<VertexType, EdgeType, Storage, Direction>::alt_landmarks
+		//
+
+		/*! @brief Precomputed landmark distances for goal-directed (ALT) shortest path searches.
+		 *  @details Holds the distances from a small set of landmark vertices to every vertex,
+		 *           from which the triangle inequality yields lower bounds on the distance between
+		 *           any two vertices. The bounds remain valid when edges are removed or made more
+		 *           expensive, or when searches are restricted through an edge constraint. After
+		 *           adding edges or lowering weights, landmarks must be recomputed, otherwise
+		 *           searches may return paths that are not the shortest. Vertices added after the
+		 *           computation are searched without a bound. See Graph::landmarks().
+		 */
+		class alt_landmarks
+		{
+			friend class Graph<VertexType, EdgeType, Storage, Direction>;
+
+		public:
+
+			alt_landmarks()
+				: _k(0),
+				  _landmarks(),
+				  _ids(),
+				  _distance()
+			{ }
+
+			/*! @brief returns the number of landmarks */
+			inline std::size_t count() const
+			{
+				return _k;
+			}
+
+			/*! @brief returns the ids of the landmark vertices */
+			inline const std::vector<std::size_t>& ids() const
+			{
+				return _landmarks;
+			}
+
+		private:
+
+			// lower bound on the distance between the vertices with storage indices *v* and *t*
+			inline double _lower_bound(std::size_t v, std::size_t vid, std::size_t t,
+									   std::size_t tid) const
+			{
+				if (v >= _ids.size() || t >= _ids.size() || _ids[v] != vid || _ids[t] != tid)
+					return 0;
+
+				const double* dv = &_distance[v * _k];
+				const double* dt = &_distance[t * _k];
+				double h = 0;
+
+				// d(v, t) >= d(L, t) - d(L, v) holds in both graphs, the reverse difference only
+				// bounds undirected distances
+				for (std::size_t l = 0; l < _k; l++) {
+					if (!std::isinf(dv[l]) && !std::isinf(dt[l])) {
+						double d = dt[l] - dv[l];
+						h = std::max(h, Direction::is_directed ? d : std::fabs(d));
+					}
+				}
+
+				return h;
+			}
+
+			std::size_t _k;
+			std::vector<std::size_t> _landmarks;
+
+			// vertex id per storage index at computation time
+			std::vector<std::size_t> _ids;
+
+			// _k distances per storage index
+			std::vector<double> _distance;
+		};
+
+		//
+		// plexum::Graph<VertexType, EdgeType, Storage, Direction>::path_enumerator<W, F>
+		//
+
+		/*! @brief Lazily enumerates loopless paths between two vertices by increasing total weight.
+		 *  @details Runs Yen's algorithm, computing each path only when it is requested, so callers
+		 *           can stop as soon as they found a suitable one. A shortest path tree towards the
+		 *           target is computed once and shared by all deviations: a deviation whose tree
+		 *           path is not blocked is taken from the tree directly, and all other deviation
+		 *           searches use the exact tree distances as A* bounds. The graph must not be
+		 *           modified while paths are enumerated. See Graph::k_shortest_paths().
+		 *  @tparam W the edge weight functor type
+		 *  @tparam F the edge constraint functor type
+		 */
+		template<typename W, typename F>
+		class path_enumerator
+		{
+			friend class Graph<VertexType, EdgeType, Storage, Direction>;
+
+		public:
+
+			typedef std::vector<typename edge_proxy::iterator> path_type;
+
+			//
+			// plexum::Graph<VertexType, EdgeType, Storage, Direction>::path_enumerator<W, F>::iterator
+			//
+
+			/*! @brief an input iterator computing the next path when incremented */
+			class iterator : public std::iterator<std::input_iterator_tag, path_type>
+			{
+				friend class path_enumerator<W, F>;
+
+			public:
+
+				iterator()
+					: _e(nullptr)
+				{ }
+
+				inline const path_type& operator*() const
+				{
+					return _e->_current;
+				}
+
+				inline const path_type* operator->() const
+				{
+					return &(_e->_current);
+				}
+
+				inline iterator& operator++()
+				{
+					if (!_e->next())
+						_e = nullptr;
+
+					return *this;
+				}
+
+				inline bool operator==(const iterator& other) const
+				{
+					return _e == other._e;
+				}
+
+				inline bool operator!=(const iterator& other) const
+				{
+					return _e != other._e;
+				}
+
+			private:
+
+				explicit iterator(path_enumerator<W, F>* e)
+					: _e(e)
+				{ }
+
+				path_enumerator<W, F>* _e;
+			};
+
+			/*! @brief computes the next path
+			 *  @return false if there are no more paths or k paths have been produced
+			 */
+			bool next()
+			{
+				if (_exhausted || _found.size() == _k) {
+					_exhausted = true;
+					_current.clear();
+					return false;
+				}
+
+				if (_found.empty()) {
+					_build_tree();
+					_path p;
+
+					if (!_tree_path(_start, p)) {
+						_exhausted = true;
+						return false;
+					}
+
+					_seen.insert(p.edges);
+					_found.push_back(p);
+				} else {
+					_deviate(_found.back());
+
+					if (_candidates.empty()) {
+						_exhausted = true;
+						_current.clear();
+						return false;
+					}
+
+					std::pop_heap(_candidates.begin(), _candidates.end(), _heavier);
+					_found.push_back(_candidates.back());
+					_candidates.pop_back();
+				}
+
+				_current.clear();
+
+				for (edge_container<EdgeType>* e : _found.back().edges)
+					_current.push_back(typename edge_proxy::iterator(_g, _g->edges._edges.find(e->_id)));
+
+				return true;
+			}
+
+			/*! @brief returns the most recently computed path */
+			inline const path_type& path() const
+			{
+				return _current;
+			}
+
+			/*! @brief returns the total weight of the most recently computed path */
+			inline double weight() const
+			{
+				return _found.empty() ? 0 : _found.back().weight;
+			}
+
+			/*! @brief returns an iterator to the current path, computing the first path if needed */
+			iterator begin()
+			{
+				if (_found.empty() && !_exhausted)
+					next();
+
+				return _exhausted ? end() : iterator(this);
+			}
+
+			inline iterator end()
+			{
+				return iterator();
+			}
+
+		private:
+
+			struct _path
+			{
+				std::vector<edge_container<EdgeType>*> edges;
+				std::vector<vertex_container<VertexType>*> vertices;
+				double weight;
+			};
+
+			static bool _heavier(const _path& a, const _path& b)
+			{
+				return a.weight > b.weight;
+			}
+
+			path_enumerator(Graph<VertexType, EdgeType, Storage, Direction>* g,
+							vertex_container<VertexType>* start,
+							vertex_container<VertexType>* target,
+							std::size_t k, W weight, F cstr)
+				: _g(g),
+				  _start(start),
+				  _target(target),
+				  _k(k),
+				  _weight(weight),
+				  _cstr(cstr),
+				  _found(),
+				  _candidates(),
+				  _seen(),
+				  _to_target(),
+				  _tree(),
+				  _epoch(0),
+				  _blocked_vertices(),
+				  _blocked_edges(),
+				  _ws(),
+				  _current(),
+				  _exhausted(false)
+			{ }
+
+			inline static std::size_t _vertex_index(vertex_container<VertexType>* v)
+			{
+				return vertex_storage::index(v->_id);
+			}
+
+			inline static std::size_t _edge_index(edge_container<EdgeType>* e)
+			{
+				return edge_storage::index(e->_id);
+			}
+
+			inline static vertex_container<VertexType>* _other(edge_container<EdgeType>* e,
+															   vertex_container<VertexType>* v)
+			{
+				return e->_from == v ? e->_to : e->_from;
+			}
+
+			// the shortest path tree towards the target on the unblocked graph
+			void _build_tree()
+			{
+				_g->template _dijkstra<true>(_target, nullptr, _weight, _cstr, _ws);
+
+				_to_target.assign(_g->vertices._vertices.bound(), std::numeric_limits<double>::infinity());
+				_tree.assign(_g->vertices._vertices.bound(), nullptr);
+				_blocked_vertices.assign(_g->vertices._vertices.bound(), 0);
+				_blocked_edges.assign(_g->edges._edges.bound(), 0);
+				_epoch = 1;
+
+				for (auto& p : _g->vertices._vertices) {
+					std::size_t i = vertex_storage::index(p.first);
+
+					if (_ws._is_visited(i)) {
+						_to_target[i] = _ws._distance[i];
+						_tree[i] = _ws._parent[i];
+					}
+				}
+			}
+
+			// the tree path from *v* to the target, unless it runs through a blocked element
+			bool _tree_path(vertex_container<VertexType>* v, _path& p)
+			{
+				if (std::isinf(_to_target[_vertex_index(v)]))
+					return false;
+
+				p.weight = _to_target[_vertex_index(v)];
+				p.vertices.push_back(v);
+
+				while (v != _target) {
+					edge_container<EdgeType>* e = _tree[_vertex_index(v)];
+					v = _other(e, v);
+
+					if (_blocked_edges[_edge_index(e)] == _epoch
+						|| _blocked_vertices[_vertex_index(v)] == _epoch)
+						return false;
+
+					p.edges.push_back(e);
+					p.vertices.push_back(v);
+				}
+
+				return true;
+			}
+
+			// the shortest path from *spur* to the target avoiding blocked vertices and edges
+			bool _spur_path(vertex_container<VertexType>* spur, _path& p)
+			{
+				if (_tree_path(spur, p))
+					return true;
+
+				p.edges.clear();
+				p.vertices.clear();
+
+				bool found = _g->_best_first(spur, _target, _weight,
+					[this](const typename vertex_container<VertexType>::adjacency& a) {
+						std::size_t i = _vertex_index(a.vertex);
+						return _blocked_vertices[i] != _epoch
+							&& _blocked_edges[_edge_index(a.edge)] != _epoch
+							&& !std::isinf(_to_target[i])
+							&& _cstr(&(a.edge->_element));
+					},
+					[this](std::size_t i, vertex_container<VertexType>*) {
+						return _to_target[i];
+					},
+					_ws);
+
+				if (!found)
+					return false;
+
+				p.weight = _ws._distance[_vertex_index(_target)];
+
+				for (vertex_container<VertexType>* v = _target; v != spur; ) {
+					edge_container<EdgeType>* e = _ws._parent[_vertex_index(v)];
+					p.vertices.push_back(v);
+					p.edges.push_back(e);
+					v = _other(e, v);
+				}
+
+				p.vertices.push_back(spur);
+				std::reverse(p.vertices.begin(), p.vertices.end());
+				std::reverse(p.edges.begin(), p.edges.end());
+				return true;
+			}
+
+			// adds the deviations of *last* from each of its vertices to the candidates
+			void _deviate(const _path& last)
+			{
+				double root_weight = 0;
+
+				for (std::size_t i = 0; i + 1 < last.vertices.size(); i++) {
+					if (++_epoch == 0) {
+						std::fill(_blocked_vertices.begin(), _blocked_vertices.end(), 0);
+						std::fill(_blocked_edges.begin(), _blocked_edges.end(), 0);
+						_epoch = 1;
+					}
+
+					// the root path may not be revisited, and known paths sharing the root may
+					// not be continued the same way
+					for (std::size_t j = 0; j < i; j++)
+						_blocked_vertices[_vertex_index(last.vertices[j])] = _epoch;
+
+					for (const _path& p : _found)
+						if (p.edges.size() > i && std::equal(last.edges.begin(),
+															 last.edges.begin() + i, p.edges.begin()))
+							_blocked_edges[_edge_index(p.edges[i])] = _epoch;
+
+					_path spur;
+
+					if (_spur_path(last.vertices[i], spur)) {
+						_path c;
+						c.edges.assign(last.edges.begin(), last.edges.begin() + i);
+						c.edges.insert(c.edges.end(), spur.edges.begin(), spur.edges.end());
+						c.vertices.assign(last.vertices.begin(), last.vertices.begin() + i);
+						c.vertices.insert(c.vertices.end(), spur.vertices.begin(), spur.vertices.end());
+						c.weight = root_weight + spur.weight;
+
+						if (_seen.insert(c.edges).second) {
+							_candidates.push_back(c);
+							std::push_heap(_candidates.begin(), _candidates.end(), _heavier);
+						}
+					}
+
+					root_weight += _weight(&(last.edges[i]->_element));
+				}
+			}
+
+			Graph<VertexType, EdgeType, Storage, Direction>* _g;
+			vertex_container<VertexType>* _start;
+			vertex_container<VertexType>* _target;
+			std::size_t _k;
+			W _weight;
+			F _cstr;
+
+			std::vector<_path> _found;
+			std::vector<_path> _candidates;
+			std::set<std::vector<edge_container<EdgeType>*>> _seen;
+
+			// distance to the target and next edge towards it per vertex storage index
+			std::vector<double> _to_target;
+			std::vector<edge_container<EdgeType>*> _tree;
+
+			// blocked vertices and edges are marked with the current epoch
+			std::uint32_t _epoch;
+			std::vector<std::uint32_t> _blocked_vertices;
+			std::vector<std::uint32_t> _blocked_edges;
+
+			search_workspace _ws;
+			path_type _current;
+			bool _exhausted;
+		};
+
+		//
+		// plexum::Graph<VertexType, EdgeType, Storage, Direction>::traversal<F>
+		//
+
+		/*! @brief A lazy breadth-first or depth-first traversal of the vertices reachable from a
+		 *         start vertex.
+		 *  @details Vertices are discovered one at a time while the traversal is advanced, so
+		 *           stopping early leaves the rest of the graph untouched. A breadth-first traversal
+		 *           visits vertices by increasing depth, a depth-first traversal in preorder. All
+		 *           state lives in a search_workspace, so repeated traversals do not allocate once
+		 *           the workspace has reached the graph's size. A traversal is single-pass, its
+		 *           workspace must not be used by other searches until it is finished, and the
+		 *           graph must not be modified while it runs. See Graph::bfs_range() and
+		 *           Graph::dfs_range().
+		 *  @tparam F the edge filter functor type
+		 */
+		template<typename F>
+		class traversal
+		{
+			friend class Graph<VertexType, EdgeType, Storage, Direction>;
+
+		public:
+
+			//
+			// plexum::Graph<VertexType, EdgeType, Storage, Direction>::traversal<F>::iterator
+			//
+
+			/*! @brief an input iterator discovering the next vertex when incremented */
+			class iterator : public std::iterator<std::input_iterator_tag,
+												  typename vertex_proxy::iterator>
+			{
+				friend class traversal<F>;
+
+			public:
+
+				iterator()
+					: _t(nullptr)
+				{ }
+
+				inline typename vertex_proxy::iterator operator*() const
+				{
+					return _t->vertex();
+				}
+
+				inline iterator& operator++()
+				{
+					if (!_t->next())
+						_t = nullptr;
+
+					return *this;
+				}
+
+				/*! @brief returns the number of edges between the start and the current vertex */
+				inline std::size_t depth() const
+				{
+					return _t->depth();
+				}
+
+				/*! @brief returns the edge the current vertex was discovered through */
+				inline typename edge_proxy::iterator parent_edge() const
+				{
+					return _t->parent_edge();
+				}
+
+				inline bool operator==(const iterator& other) const
+				{
+					return _t == other._t;
+				}
+
+				inline bool operator!=(const iterator& other) const
+				{
+					return _t != other._t;
+				}
+
+			private:
+
+				explicit iterator(traversal<F>* t)
+					: _t(t)
+				{ }
+
+				traversal<F>* _t;
+			};
+
+			/*! @brief discovers the next vertex
+			 *  @return false if all reachable vertices have been visited
+			 */
+			bool next()
+			{
+				if (_current == nullptr)
+					return false;
+
+				_current = _depth_first ? _next_depth_first() : _next_breadth_first();
+				return _current != nullptr;
+			}
+
+			/*! @brief returns the current vertex */
+			inline typename vertex_proxy::iterator vertex() const
+			{
+				return typename vertex_proxy::iterator(_g, _g->vertices._vertices.find(_current->_id));
+			}
+
+			/*! @brief returns the number of edges between the start and the current vertex */
+			inline std::size_t depth() const
+			{
+				return _depth_first ? _ws->_stack.size() - 1 : _depth;
+			}
+
+			/*! @brief returns the edge the current vertex was discovered through or edges.end() for
+			 *         the start vertex
+			 */
+			inline typename edge_proxy::iterator parent_edge() const
+			{
+				edge_container<EdgeType>* e = _ws->_parent[vertex_storage::index(_current->_id)];
+
+				return typename edge_proxy::iterator(_g, e == nullptr ? _g->edges._edges.end()
+																	  : _g->edges._edges.find(e->_id));
+			}
+
+			/*! @brief returns an iterator to the current vertex */
+			inline iterator begin()
+			{
+				return _current == nullptr ? end() : iterator(this);
+			}
+
+			inline iterator end()
+			{
+				return iterator();
+			}
+
+		private:
+
+			traversal(Graph<VertexType, EdgeType, Storage, Direction>* g, vertex_container<VertexType>* start,
+					  F filter, bool depth_first, search_workspace& ws)
+				: _g(g),
+				  _filter(filter),
+				  _depth_first(depth_first),
+				  _ws(&ws),
+				  _current(start),
+				  _head(0),
+				  _tail(0),
+				  _level_end(1),
+				  _depth(0)
+			{
+				_ws->_reset(_g->vertices._vertices.bound());
+				_ws->_visit(vertex_storage::index(start->_id), nullptr);
+				_ws->_stack.clear();
+
+				if (_depth_first)
+					_ws->_stack.push_back(std::make_pair(start, std::size_t(0)));
+				else
+					_ws->_frontier[_tail++] = start;
+			}
+
+			// expands the current vertex and moves on to the next one in the queue
+			vertex_container<VertexType>* _next_breadth_first()
+			{
+				vertex_container<VertexType>* c = _ws->_frontier[_head++];
+				_ws->_expanded++;
+
+				for (auto& a : c->_neighbors) {
+					std::size_t i = vertex_storage::index(a.vertex->_id);
+
+					if (!_ws->_is_visited(i) && _filter(&(a.edge->_element))) {
+						_ws->_visit(i, a.edge);
+						_ws->_frontier[_tail++] = a.vertex;
+					}
+				}
+
+				if (_head == _level_end) {
+					_level_end = _tail;
+					_depth++;
+				}
+
+				return _head == _tail ? nullptr : _ws->_frontier[_head];
+			}
+
+			// descends into the next undiscovered neighbor, backtracking where there is none
+			vertex_container<VertexType>* _next_depth_first()
+			{
+				while (!_ws->_stack.empty()) {
+					vertex_container<VertexType>* c = _ws->_stack.back().first;
+					std::size_t& k = _ws->_stack.back().second;
+
+					if (k == 0)
+						_ws->_expanded++;
+
+					while (k < c->_neighbors.size()) {
+						auto& a = c->_neighbors[k++];
+						std::size_t i = vertex_storage::index(a.vertex->_id);
+
+						if (!_ws->_is_visited(i) && _filter(&(a.edge->_element))) {
+							_ws->_visit(i, a.edge);
+							_ws->_stack.push_back(std::make_pair(a.vertex, std::size_t(0)));
+							return a.vertex;
+						}
+					}
+
+					_ws->_stack.pop_back();
+				}
+
+				return nullptr;
+			}
+
+			Graph<VertexType, EdgeType, Storage, Direction>* _g;
+			F _filter;
+			bool _depth_first;
+			search_workspace* _ws;
+			vertex_container<VertexType>* _current;
+
+			// breadth-first queue bounds in the workspace frontier, where the current depth ends
+			std::size_t _head;
+			std::size_t _tail;
+			std::size_t _level_end;
+			std::size_t _depth;
+		};
+
+	public:
+
+		/*! @brief constructs a new Graph object
+		 *  @param resource the memory resource all vertex and edge storage and adjacency lists
+		 *         are allocated from, which must outlive the graph, e.g. a monotonic_arena
+		 */
+		explicit Graph(memory_resource* resource = new_delete_resource())
+			: vertices(this, resource),
+			  edges(this, resource),
+			  _supergraph(nullptr),
+			  _subgraph_position(0),
+			  _subgraphs(),
+			  _vertex_demand(),
+			  _edge_demand(),
+			  _workspace(),
+			  _resource(resource),
+			  _tracking_components(false),
+			  _components_stale(true),
+			  _components(),
+			  _merges(0),
+			  _version(0),
+			  _additions(0),
+			  _removals(0),
+			  _path_cache(),
+			  _path_cache_stats()
+		{ }
+
+		/*! @brief returns the memory resource of the graph */
+		inline memory_resource* resource() const
+		{
+			return _resource;
+		}
+
+		/*! @brief maps the graph *subgraph* onto the graph, unmapping it from its previous
+		 *         supergraph
+		 *  @param subgraph the subgraph to be mapped
+		 */
+		void map(Graph<VertexType, EdgeType, Storage, Direction>* subgraph)
+		{
+			if (subgraph->_supergraph == this)
+				return;
+
+			if (subgraph->_supergraph != nullptr)
+				subgraph->_supergraph->unmap(subgraph);
+
+			subgraph->_supergraph = this;
+			subgraph->_subgraph_position = _subgraphs.size();
+			_subgraphs.push_back(subgraph);
+		}
+
+		/*! @brief checks if *subgraph* is mapped onto the graph
+ 		 *  @param subgraph the subgraph to be checked
+ 		 *  @return true if *subgraph* is mapped, false otherwise
+ 		 */
+		bool has_subgraph(Graph<VertexType, EdgeType, Storage, Direction>* subgraph) const
+		{
+			return subgraph->_supergraph == this;
+		}
+
+		/*! @brief checks whether the graph has any subgraphs mapped
+	  	 *  @return true if there are mapped subgraphs, false otherwise
+	  	 */
+		bool has_subgraphs() const
+		{
+			return !_subgraphs.empty();
+		}
+
+		/*! @brief unmaps *subgraph* from the graph in O(1), moving the last subgraph into its
+		 *         place in subgraphs()
+   		 *  @param subgraph the subgraph to be unmapped
+   		 */
+		void unmap(Graph<VertexType, EdgeType, Storage, Direction>* subgraph)
+		{
+			if(subgraph->_supergraph == this) {
+				std::size_t pos = subgraph->_subgraph_position;
+				_subgraphs[pos] = _subgraphs.back();
+				_subgraphs[pos]->_subgraph_position = pos;
+				_subgraphs.pop_back();
+				subgraph->_supergraph = nullptr;
+			} else {
+				throw exception("Graph::unmap(): specified graph is not a subgraph");
+			}
+		}
+
+		/*! @brief sets the demands vertices and edges mapped onto the graph add to the load of
+		 *         their super vertex or edge
+		 *  @details *vertex_demand* and *edge_demand* are called with the value of a vertex or
+		 *           edge when it is mapped, the result is added to the load() of the vertex or
+		 *           each edge it is mapped onto and subtracted again when it is unmapped. Loads
+		 *           thus sum up a resource, e.g. the CPU or bandwidth requirements of virtual
+		 *           nodes and links placed on a substrate. Without demands, all loads are 0.
+		 *           The demands must be set while nothing is mapped onto the graph.
+		 */
+		template<typename VF, typename EF>
+		void set_demand(VF vertex_demand, EF edge_demand)
+		{
+			_vertex_demand = vertex_demand;
+			_edge_demand = edge_demand;
+		}
+
+		/*! @brief embeds the graph *request* onto the graph, placing all its vertices and routing
+		 *         all its edges at once
+		 *  @details The graph is a substrate whose vertices and edges offer the capacity
+		 *           *vertex_capacity* and *edge_capacity* return for their value, minus their
+		 *           current load(). The vertices of *request* demand what is set by set_demand().
+		 *
+		 *           They are placed in order of decreasing demand, each on the substrate vertex
+		 *           with the most residual capacity that does not host another vertex of the
+		 *           request. The edges are then routed, again in order of decreasing demand, on
+		 *           the path with the least number of substrate edges whose residual capacity
+		 *           covers the demand. Residual capacities are reserved as elements are placed.
+		 *           The breadth-first tree found for a substrate vertex is reused for other
+		 *           edges of the same demand leaving it as long as the path it holds still has
+		 *           enough capacity.
+		 *
+		 *           If everything fits, the request is mapped onto the graph through map(),
+		 *           vertex_proxy::iterator::map() and edge_proxy::iterator::map_path(), which
+		 *           adds its demands to the substrate loads. Otherwise nothing is changed.
+		 *  @return true if the request was embedded
+		 *  @throws exception if *request* is already mapped onto a graph
+		 */
+		template<typename VC, typename EC>
+		bool embed(Graph<VertexType, EdgeType, Storage, Direction>* request, VC vertex_capacity,
+				   EC edge_capacity)
+		{
+			typedef vertex_container<VertexType> vc;
+			typedef edge_container<EdgeType> ec;
+
+			if (request->_supergraph != nullptr)
+				throw exception("Graph::embed(): request is already mapped onto a graph");
+
+			const std::size_t npos = static_cast<std::size_t>(-1);
+			_embedding_state st(vertices._vertices.bound(), edges._edges.bound());
+
+			for (auto& p : vertices._vertices) {
+				std::size_t i = vertex_storage::index(p.first);
+				st.substrate[i] = &p.second;
+				st.vertex_residual[i] = vertex_capacity(p.second._element) - p.second._load;
+			}
+
+			for (auto& p : edges._edges) {
+				std::size_t i = edge_storage::index(p.first);
+				st.edge_residual[i] = edge_capacity(p.second._element) - p.second._load;
+			}
+
+			// vertices in order of decreasing demand, each with its demand and host
+			std::vector<std::tuple<double, vc*, std::size_t>> vs;
+			std::vector<std::size_t> host(request->vertices._vertices.bound(), npos);
+
+			for (auto& p : request->vertices._vertices)
+				vs.push_back(std::make_tuple(_vertex_demand ? _vertex_demand(p.second._element) : 0,
+											 &p.second, npos));
+
+			std::stable_sort(vs.begin(), vs.end(), _by_decreasing_demand());
+
+			for (auto& v : vs) {
+				double d = std::get<0>(v);
+				std::size_t best = npos;
+
+				for (std::size_t i = 0; i < st.substrate.size(); i++)
+					if (st.substrate[i] != nullptr && !st.hosting[i] && st.vertex_residual[i] >= d
+						&& (best == npos || st.vertex_residual[i] > st.vertex_residual[best]))
+						best = i;
+
+				if (best == npos)
+					return false;
+
+				st.hosting[best] = true;
+				st.vertex_residual[best] -= d;
+				std::get<2>(v) = best;
+				host[vertex_storage::index(std::get<1>(v)->_id)] = best;
+			}
+
+			// edges in order of decreasing demand, each with its demand and the offset of its
+			// route in routes
+			std::vector<std::tuple<double, ec*, std::size_t>> es;
+			std::vector<ec*> routes;
+
+			for (auto& p : request->edges._edges)
+				es.push_back(std::make_tuple(_edge_demand ? _edge_demand(p.second._element) : 0,
+											 &p.second, npos));
+
+			std::stable_sort(es.begin(), es.end(), _by_decreasing_demand());
+
+			for (auto& e : es) {
+				double d = std::get<0>(e);
+				std::size_t s = host[vertex_storage::index(std::get<1>(e)->_from->_id)];
+				std::size_t t = host[vertex_storage::index(std::get<1>(e)->_to->_id)];
+				std::size_t first = routes.size();
+
+				if (!_route(st, s, t, d, routes))
+					return false;
+
+				for (std::size_t k = first; k < routes.size(); k++)
+					st.edge_residual[edge_storage::index(routes[k]->_id)] -= d;
+
+				std::get<2>(e) = first;
+			}
+
+			map(request);
+
+			for (auto& v : vs)
+				vertices[st.substrate[std::get<2>(v)]->_id].map(
+					request->vertices[std::get<1>(v)->_id]);
+
+			for (std::size_t j = 0; j < es.size(); j++) {
+				std::size_t last = j + 1 < es.size() ? std::get<2>(es[j + 1]) : routes.size();
+				auto sub = request->edges[std::get<1>(es[j])->_id];
+
+				sub._container()._clear_super_edges();
+
+				for (std::size_t k = std::get<2>(es[j]); k < last; k++)
+					edges[routes[k]->_id].map_path(sub);
+			}
+
+			return true;
+		}
+
+		/*! @brief removes an embedding made by embed(), unmapping all vertices and edges of
+		 *         *request* and releasing their demands
+		 *  @throws exception if *request* is not mapped onto the graph
+		 */
+		void unembed(Graph<VertexType, EdgeType, Storage, Direction>* request)
+		{
+			if (request->_supergraph != this)
+				throw exception("Graph::unembed(): specified graph is not a subgraph");
+
+			for (auto& p : request->vertices._vertices)
+				if (p.second._super_vertex != nullptr)
+					p.second._super_vertex->_remove_sub_vertex(&p.second);
+
+			for (auto& p : request->edges._edges)
+				p.second._clear_super_edges();
+
+			unmap(request);
+		}
+
+		/*! @brief returns a pointer to the graph's super-graph
+		 *  @return a pointer to the super-graph or std::nullptr if there is no super-graph
+		 */
+		const Graph<VertexType, EdgeType, Storage, Direction>* supergraph()
+		{
+			return _supergraph;
+		};
+
+		/*! @brief  returns a reference to a std::vector containing pointers
+		 * 		    to the graph's sub-graphs
+ 		 *  @return a reference to a std::vector containing pointers to the graph's sub-graph or
+ 		 *  		a reference to an empty std::vector if there are no sub-graphs
+ 		 */
+		const std::vector<Graph<VertexType, EdgeType, Storage, Direction>*>& subgraphs()
+		{
+			return _subgraphs;
+		};
+
+		/*! @brief checks whether there is a path between *a* and *b*, ignoring edge directions
+		 *  @details The first call builds a connectivity index in O(n + m), which is then kept
+		 *           up to date: adding an edge merges two components in near-constant time, and
+		 *           removing an edge or a vertex with edges marks the index stale, so it is rebuilt
+		 *           by the next call. While the index is current, find_path() and shortest_path()
+		 *           fail immediately for vertices in different components.
+		 */
+		bool connected(typename vertex_proxy::iterator a, typename vertex_proxy::iterator b)
+		{
+			return component(a) == component(b);
+		}
+
+		/*! @brief returns an id of the weakly connected component of *v*, shared by all vertices
+		 *         of the component until the graph is modified, see connected()
+		 */
+		std::size_t component(typename vertex_proxy::iterator v)
+		{
+			_refresh_components();
+			return _components.find(vertex_storage::index(v.id()));
+		}
+
+		/*! @brief returns the number of weakly connected components, see connected() */
+		std::size_t component_count()
+		{
+			_refresh_components();
+			return vertices.count() - _merges;
+		}
+
+		/*! @brief stops maintaining the connectivity index until connected(), component() or
+		 *         component_count() is called again
+		 */
+		void drop_components()
+		{
+			_tracking_components = false;
+			_components_stale = true;
+			_components.clear();
+		}
+
+		/*! @brief returns a counter incremented by every change to the vertices or edges of the
+		 *         graph, so results computed at equal versions are computed on equal topologies
+		 *  @details changes to vertex and edge values are not counted
+		 */
+		inline std::size_t version() const
+		{
+			return _version;
+		}
+
+		/*! @brief keeps the results of up to *capacity* path queries made with a path_tag, see
+		 *         find_path(start, target, cstr, path_tag)
+		 *  @details Entries are evicted in least recently used order once the cache is full, and
+		 *           a capacity of 0 disables the cache and drops all entries. Adding an edge
+		 *           invalidates every entry, as the new edge may shorten any path. Removing an
+		 *           edge only invalidates the entries whose paths run over it, which is checked
+		 *           when such an entry is hit. Adding or removing a vertex without edges does not
+		 *           invalidate any entry.
+		 */
+		void enable_path_cache(std::size_t capacity)
+		{
+			_path_cache.set_capacity(capacity);
+		}
+
+		/*! @brief drops all cached paths, e.g. after changing the values a constraint depends on */
+		void clear_path_cache()
+		{
+			_path_cache.clear();
+		}
+
+		/*! @brief returns the hit, miss, eviction and invalidation counters of the path cache */
+		inline path_cache_stats path_cache_statistics() const
+		{
+			return _path_cache_stats;
+		}
+
+		/*! @brief finds a path with the least number of edges between *start* and *target*
+		 *  @return the edges along the path, ordered from *start* to *target*
+		 *  @throws exception if there is no path between *start* and *target*
+		 */
+		std::vector<typename edge_proxy::iterator> find_path(typename vertex_proxy::iterator start,
+															 typename vertex_proxy::iterator target)
+		{
+			return find_path(start, target, [](EdgeType*) { return true; });
+		}
+
+		/*! @brief finds a path with the least number of edges between *start* and *target* only
+		 *         using edges *e* for which *cstr(e)* holds
+		 *  @details runs a breadth-first search in O(n + m) on the graph's internal workspace
+		 *  @return the edges along the path, ordered from *start* to *target*
+		 *  @throws exception if there is no such path between *start* and *target*
+		 */
+		template<typename F>
+		std::vector<typename edge_proxy::iterator> find_path(typename vertex_proxy::iterator start,
+															 typename vertex_proxy::iterator target,
+															 F cstr)
+		{
+			return find_path(start, target, cstr, _workspace);
+		}
+
+		/*! @brief same as find_path(start, target, cstr), using the caller-provided workspace *ws*
+		 *  @details allows concurrent searches on an otherwise unmodified graph, one workspace per
+		 *           thread
+		 */
+		template<typename F>
+		std::vector<typename edge_proxy::iterator> find_path(typename vertex_proxy::iterator start,
+															 typename vertex_proxy::iterator target,
+															 F cstr, search_workspace& ws)
+		{
+			if (_separated(&start._container(), &target._container())
+				|| !_bfs(&start._container(), &target._container(), cstr, ws))
+				throw exception("there is no path between the specified vertices");
+
+			return _trace_path(&start._container(), &target._container(), ws);
+		}
+
+		/*! @brief same as find_path(start, target, cstr), answered from the path cache if it
+		 *         holds a valid result for *start*, *target* and *tag*
+		 *  @details *tag* stands for *cstr* in the cache, so every constraint needs its own tag,
+		 *           and a constraint depending on vertex or edge values needs a call to
+		 *           clear_path_cache() when these values change. Paths are only cached while
+		 *           enable_path_cache() set a capacity greater than 0, failed searches are never
+		 *           cached.
+		 */
+		template<typename F>
+		std::vector<typename edge_proxy::iterator> find_path(typename vertex_proxy::iterator start,
+															 typename vertex_proxy::iterator target,
+															 F cstr, path_tag tag)
+		{
+			_path_key key = {start.id(), target.id(), tag.id};
+			_cached_path* cached = _path_cache.find(key);
+
+			if (cached != nullptr && _revalidate(*cached)) {
+				_path_cache_stats.hits++;
+				return cached->path;
+			}
+
+			if (cached != nullptr) {
+				_path_cache.erase(key);
+				_path_cache_stats.invalidations++;
+			}
+
+			_path_cache_stats.misses++;
+
+			std::vector<typename edge_proxy::iterator> path = find_path(start, target, cstr,
+																		_workspace);
+
+			if (_path_cache.capacity() != 0) {
+				_cached_path entry = {_additions, _removals, {}, path};
+
+				for (auto& e : path)
+					entry.ids.push_back(e.id());
+
+				_path_cache_stats.evictions += _path_cache.insert(key, std::move(entry));
+			}
+
+			return path;
+		}
+
+		/*! @brief finds a path between *start* and *target* with the least total edge weight
+		 *  @param weight a functor returning the non-negative weight of an edge given an EdgeType*
+		 *  @return the edges along the path, ordered from *start* to *target*
+		 *  @throws exception if there is no path between *start* and *target*
+		 */
+		template<typename W>
+		std::vector<typename edge_proxy::iterator> shortest_path(
+			typename vertex_proxy::iterator start,
+			typename vertex_proxy::iterator target,
+			W weight)
+		{
+			return shortest_path(start, target, weight, [](EdgeType*) { return true; });
+		}
+
+		/*! @brief finds a path between *start* and *target* with the least total edge weight only
+		 *         using edges *e* for which *cstr(e)* holds
+		 *  @details runs Dijkstra's algorithm on an indexed 4-ary heap in O(m log n), stopping as
+		 *           soon as *target* is settled
+		 *  @param weight a functor returning the non-negative weight of an edge given an EdgeType*
+		 *  @param cstr a functor deciding whether an edge given as EdgeType* may be used
+		 *  @return the edges along the path, ordered from *start* to *target*
+		 *  @throws exception if there is no such path or a negative edge weight is encountered
+		 */
+		template<typename W, typename F>
+		std::vector<typename edge_proxy::iterator> shortest_path(
+			typename vertex_proxy::iterator start,
+			typename vertex_proxy::iterator target,
+			W weight, F cstr)
+		{
+			return shortest_path(start, target, weight, cstr, _workspace);
+		}
+
+		/*! @brief same as shortest_path(start, target, weight, cstr), using the caller-provided
+		 *         workspace *ws*
+		 */
+		template<typename W, typename F>
+		std::vector<typename edge_proxy::iterator> shortest_path(
+			typename vertex_proxy::iterator start,
+			typename vertex_proxy::iterator target,
+			W weight, F cstr, search_workspace& ws)
+		{
+			if (_separated(&start._container(), &target._container())
+				|| !_dijkstra(&start._container(), &target._container(), weight, cstr, ws))
+				throw exception("there is no path between the specified vertices");
+
+			return _trace_path(&start._container(), &target._container(), ws);
+		}
+
+		/*! @brief finds a path with the least number of edges between *start* and *target* with a
+		 *         breadth-first search expanding from both endpoints
+		 *  @details expands the smaller of the two frontiers one level at a time, which explores
+		 *           far fewer vertices than a single search on large sparse graphs. Searching
+		 *           from the target requires incoming edges, so this is not available for
+		 *           plexum::directed graphs.
+		 *  @return the edges along the path, ordered from *start* to *target*
+		 *  @throws exception if there is no such path between *start* and *target*
+		 */
+		template<typename F>
+		std::vector<typename edge_proxy::iterator> find_path(typename vertex_proxy::iterator start,
+															 typename vertex_proxy::iterator target,
+															 F cstr, bidirectional_search s)
+		{
+			return find_path(start, target, cstr, s, _workspace);
+		}
+
+		/*! @brief same as find_path(start, target, cstr, bidirectional_search), using the
+		 *         caller-provided workspace *ws*
+		 */
+		template<typename F>
+		std::vector<typename edge_proxy::iterator> find_path(typename vertex_proxy::iterator start,
+															 typename vertex_proxy::iterator target,
+															 F cstr, bidirectional_search,
+															 search_workspace& ws)
+		{
+			if (_separated(&start._container(), &target._container()))
+				throw exception("there is no path between the specified vertices");
+
+			_meeting m = _bidirectional_bfs(&start._container(), &target._container(), cstr, ws);
+			return _trace_path(&start._container(), &target._container(), m, ws);
+		}
+
+		/*! @brief finds a path between *start* and *target* with the least total edge weight with
+		 *         Dijkstra searches expanding from both endpoints
+		 *  @details not available for plexum::directed graphs, see find_path()
+		 *  @return the edges along the path, ordered from *start* to *target*
+		 *  @throws exception if there is no such path or a negative edge weight is encountered
+		 */
+		template<typename W, typename F>
+		std::vector<typename edge_proxy::iterator> shortest_path(
+			typename vertex_proxy::iterator start,
+			typename vertex_proxy::iterator target,
+			W weight, F cstr, bidirectional_search s)
+		{
+			return shortest_path(start, target, weight, cstr, s, _workspace);
+		}
+
+		/*! @brief same as shortest_path(start, target, weight, cstr, bidirectional_search), using
+		 *         the caller-provided workspace *ws*
+		 */
+		template<typename W, typename F>
+		std::vector<typename edge_proxy::iterator> shortest_path(
+			typename vertex_proxy::iterator start,
+			typename vertex_proxy::iterator target,
+			W weight, F cstr, bidirectional_search, search_workspace& ws)
+		{
+			if (_separated(&start._container(), &target._container()))
+				throw exception("there is no path between the specified vertices");
+
+			_meeting m = _bidirectional_dijkstra(&start._container(), &target._container(),
+												 weight, cstr, ws);
+			return _trace_path(&start._container(), &target._container(), m, ws);
+		}
+
+		/*! @brief finds a path between *start* and *target* with the least total edge weight with an
+		 *         A* search guided by the landmark lower bounds *lm*
+		 *  @param lm landmarks computed by landmarks() for the same *weight*
+		 *  @return the edges along the path, ordered from *start* to *target*
+		 *  @throws exception if there is no such path or a negative edge weight is encountered
+		 */
+		template<typename W, typename F>
+		std::vector<typename edge_proxy::iterator> shortest_path(
+			typename vertex_proxy::iterator start,
+			typename vertex_proxy::iterator target,
+			W weight, F cstr, const alt_landmarks& lm)
+		{
+			return shortest_path(start, target, weight, cstr, lm, _workspace);
+		}
+
+		/*! @brief same as shortest_path(start, target, weight, cstr, lm), using the caller-provided
+		 *         workspace *ws*
+		 */
+		template<typename W, typename F>
+		std::vector<typename edge_proxy::iterator> shortest_path(
+			typename vertex_proxy::iterator start,
+			typename vertex_proxy::iterator target,
+			W weight, F cstr, const alt_landmarks& lm, search_workspace& ws)
+		{
+			if (_separated(&start._container(), &target._container())
+				|| !_astar(&start._container(), &target._container(), weight, cstr, lm, ws))
+				throw exception("there is no path between the specified vertices");
+
+			return _trace_path(&start._container(), &target._container(), ws);
+		}
+
+		/*! @brief enumerates up to *k* loopless paths between *start* and *target* by increasing
+		 *         total weight, only using edges *e* for which *cstr(e)* holds
+		 *  @details paths are computed lazily while the returned enumerator is advanced, see
+		 *           path_enumerator. There are no paths to enumerate if *target* is unreachable.
+		 *           The shortest path tree towards *target* follows incoming edges, so this is not
+		 *           available for plexum::directed graphs.
+		 *  @param weight a functor returning the non-negative weight of an edge given an EdgeType*
+		 *  @param cstr a functor deciding whether an edge given as EdgeType* may be used
+		 *  @return a range over the paths, each in the same form as returned by shortest_path()
+		 */
+		template<typename W, typename F>
+		path_enumerator<W, F> k_shortest_paths(typename vertex_proxy::iterator start,
+											   typename vertex_proxy::iterator target,
+											   std::size_t k, W weight, F cstr)
+		{
+			return path_enumerator<W, F>(this, &start._container(), &target._container(), k,
+										 weight, cstr);
+		}
+
+		/*! @brief lazily visits the vertices reachable from *start* in breadth-first order
+		 *  @details runs on the graph's internal workspace, see traversal
+		 */
+		traversal<bool (*)(EdgeType*)> bfs_range(typename vertex_proxy::iterator start)
+		{
+			return bfs_range(start, &_any_edge);
+		}
+
+		/*! @brief lazily visits the vertices reachable from *start* in breadth-first order, only
+		 *         following edges *e* for which *filter(e)* holds
+		 *  @details runs on the graph's internal workspace, see traversal
+		 */
+		template<typename F>
+		traversal<F> bfs_range(typename vertex_proxy::iterator start, F filter)
+		{
+			return bfs_range(start, filter, _workspace);
+		}
+
+		/*! @brief same as bfs_range(start, filter), using the caller-provided workspace *ws* */
+		template<typename F>
+		traversal<F> bfs_range(typename vertex_proxy::iterator start, F filter, search_workspace& ws)
+		{
+			return traversal<F>(this, &start._container(), filter, false, ws);
+		}
+
+		/*! @brief lazily visits the vertices reachable from *start* in depth-first preorder
+		 *  @details runs on the graph's internal workspace, see traversal
+		 */
+		traversal<bool (*)(EdgeType*)> dfs_range(typename vertex_proxy::iterator start)
+		{
+			return dfs_range(start, &_any_edge);
+		}
+
+		/*! @brief lazily visits the vertices reachable from *start* in depth-first preorder, only
+		 *         following edges *e* for which *filter(e)* holds
+		 *  @details runs on the graph's internal workspace, see traversal
+		 */
+		template<typename F>
+		traversal<F> dfs_range(typename vertex_proxy::iterator start, F filter)
+		{
+			return dfs_range(start, filter, _workspace);
+		}
+
+		/*! @brief same as dfs_range(start, filter), using the caller-provided workspace *ws* */
+		template<typename F>
+		traversal<F> dfs_range(typename vertex_proxy::iterator start, F filter, search_workspace& ws)
+		{
+			return traversal<F>(this, &start._container(), filter, true, ws);
+		}
+
+		/*! @brief selects *k* landmark vertices and computes their distances to all vertices
+		 *  @details landmarks are chosen greedily, each as the vertex farthest from all previously
+		 *           chosen ones, which runs *k* full Dijkstra searches and stores *k* distances per
+		 *           vertex
+		 *  @param weight a functor returning the non-negative weight of an edge given an EdgeType*
+		 *  @return the landmarks for A* searches through shortest_path()
+		 */
+		template<typename W>
+		alt_landmarks landmarks(std::size_t k, W weight)
+		{
+			alt_landmarks lm;
+			std::size_t bound = vertices._vertices.bound();
+			const double inf = std::numeric_limits<double>::infinity();
+			auto any = [](EdgeType*) { return true; };
+
+			lm._k = std::min(k, vertices.count());
+			lm._ids.assign(bound, static_cast<std::size_t>(-1));
+			lm._distance.assign(bound * lm._k, inf);
+
+			for (auto& p : vertices._vertices)
+				lm._ids[vertex_storage::index(p.first)] = p.first;
+
+			std::vector<double> closest(bound, inf);
+			vertex_container<VertexType>* next = lm._k ? &vertices._vertices.begin()->second : nullptr;
+
+			for (std::size_t l = 0; l < lm._k; l++) {
+				lm._landmarks.push_back(next->_id);
+				_dijkstra(next, nullptr, weight, any, _workspace);
+
+				for (auto& p : vertices._vertices) {
+					std::size_t i = vertex_storage::index(p.first);
+
+					if (_workspace._is_visited(i)) {
+						lm._distance[i * lm._k + l] = _workspace._distance[i];
+						closest[i] = std::min(closest[i], _workspace._distance[i]);
+					}
+				}
+
+				// unreached vertices are the farthest, so other components receive landmarks too
+				double farthest = -1;
+
+				for (auto& p : vertices._vertices) {
+					std::size_t i = vertex_storage::index(p.first);
+
+					if (closest[i] > farthest) {
+						farthest = closest[i];
+						next = &p.second;
+					}
+				}
+			}
+
+			return lm;
+		}
+
+		/*! @brief builds an immutable compressed sparse row snapshot of the graph
+		 *  @details the adjacency arrays are filled by up to *threads* threads (0 selects one per
+		 *           hardware thread); graphs with less than PARALLEL_GRAIN adjacency entries per
+		 *           thread are converted on the calling thread
+		 *  @return the snapshot, see plexum::csr_graph
+		 */
+		csr_graph<VertexType, EdgeType> freeze(unsigned threads = 0)
+		{
+			csr_graph<VertexType, EdgeType> c;
+			std::vector<vertex_container<VertexType>*> vs;
+			std::vector<edge_container<EdgeType>*> es;
+
+			vs.reserve(vertices.count());
+			es.reserve(edges.count());
+			c._vertex_ids.reserve(vertices.count());
+			c._edge_ids.reserve(edges.count());
+			c._vertices.reserve(vertices.count());
+			c._edges.reserve(edges.count());
+			c._vertex_index.assign(vertices._vertices.bound(), c.npos);
+			c._edge_index.assign(edges._edges.bound(), c.npos);
+			c._index_mask = vertex_storage::index(~std::size_t(0));
+			c._directed = Direction::is_directed;
+
+			for (auto& p : vertices._vertices) {
+				c._vertex_index[vertex_storage::index(p.first)] = vs.size();
+				c._vertex_ids.push_back(p.first);
+				c._vertices.push_back(p.second._element);
+				vs.push_back(&p.second);
+			}
+
+			for (auto& p : edges._edges) {
+				c._edge_index[edge_storage::index(p.first)] = es.size();
+				c._edge_ids.push_back(p.first);
+				c._edges.push_back(p.second._element);
+				es.push_back(&p.second);
+			}
+
+			c._offsets.resize(vs.size() + 1);
+			c._offsets[0] = 0;
+
+			for (std::size_t v = 0; v < vs.size(); v++)
+				c._offsets[v + 1] = c._offsets[v] + vs[v]->_neighbors.size();
+
+			c._adjacency.resize(c._offsets.back());
+			c._adjacency_edges.resize(c._offsets.back());
+			c._source.resize(es.size());
+			c._target.resize(es.size());
+
+			// split by adjacency entries rather than by vertices to balance high-degree vertices
+			parallel_for(0, c._adjacency.size(), threads, PARALLEL_GRAIN,
+				[&](std::size_t first, std::size_t last, unsigned) {
+					std::size_t v = std::upper_bound(c._offsets.begin(), c._offsets.end(), first)
+						- c._offsets.begin() - 1;
+
+					for (std::size_t k = first; k < last; v++) {
+						std::size_t stop = std::min(last, c._offsets[v + 1]);
+
+						for (std::size_t j = k - c._offsets[v]; k < stop; k++, j++) {
+							auto& a = vs[v]->_neighbors[j];
+							c._adjacency[k] = c._vertex_index[vertex_storage::index(a.vertex->_id)];
+							c._adjacency_edges[k] = c._edge_index[edge_storage::index(a.edge->_id)];
+						}
+					}
+				});
+
+			parallel_for(0, es.size(), threads, PARALLEL_GRAIN,
+				[&](std::size_t first, std::size_t last, unsigned) {
+					for (std::size_t e = first; e < last; e++) {
+						c._source[e] = c._vertex_index[vertex_storage::index(es[e]->_from->_id)];
+						c._target[e] = c._vertex_index[vertex_storage::index(es[e]->_to->_id)];
+					}
+				});
+
+			return c;
+		}
+
+		/*! @brief writes the graph to *os* in the Graphviz DOT language
+		 *  @details Vertices are named by their ids and labeled with the text *vertex_format*
+		 *           appends for their value, edges are labeled with the text of *edge_format*.
+		 *           Both are called as f(output_buffer&, const T&), see plexum::default_format.
+		 *           Directed graphs are written as digraphs. The text is collected in a buffer
+		 *           and written in blocks of output_buffer::DEFAULT_CAPACITY bytes.
+		 */
+		template<typename VF = default_format, typename EF = default_format>
+		void write_dot(std::ostream& os, VF vertex_format = VF(), EF edge_format = EF())
+		{
+			output_buffer out(os);
+
+			out << (Direction::is_directed ? "digraph {\n" : "graph {\n");
+
+			for (auto& p : vertices._vertices) {
+				out << "  " << p.first << " [label=\"";
+				std::size_t label = out.size();
+				vertex_format(out, p.second._element);
+				out.escape(label, output_buffer::dot_string);
+				out << "\"];\n";
+				out.commit();
+			}
+
+			for (auto& p : edges._edges) {
+				out << "  " << p.second._from->_id << (Direction::is_directed ? " -> " : " -- ")
+					<< p.second._to->_id << " [label=\"";
+				std::size_t label = out.size();
+				edge_format(out, p.second._element);
+				out.escape(label, output_buffer::dot_string);
+				out << "\"];\n";
+				out.commit();
+			}
+
+			out << "}\n";
+		}
+
+		/*! @brief writes the graph to *os* as a GraphML document
+		 *  @details Nodes and edges are identified by their ids, prefixed with 'n' and 'e'. The
+		 *           text *vertex_format* and *edge_format* append for a value is stored as its
+		 *           "value" data, see write_dot().
+		 */
+		template<typename VF = default_format, typename EF = default_format>
+		void write_graphml(std::ostream& os, VF vertex_format = VF(), EF edge_format = EF())
+		{
+			output_buffer out(os);
+
+			out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+				<< "<graphml xmlns=\"http://graphml.graphdrawing.org/xmlns\">\n"
+				<< "  <key id=\"v\" for=\"node\" attr.name=\"value\" attr.type=\"string\"/>\n"
+				<< "  <key id=\"e\" for=\"edge\" attr.name=\"value\" attr.type=\"string\"/>\n"
+				<< "  <graph id=\"G\" edgedefault=\""
+				<< (Direction::is_directed ? "directed" : "undirected") << "\">\n";
+
+			for (auto& p : vertices._vertices) {
+				out << "    <node id=\"n" << p.first << "\"><data key=\"v\">";
+				std::size_t value = out.size();
+				vertex_format(out, p.second._element);
+				out.escape(value, output_buffer::xml_text);
+				out << "</data></node>\n";
+				out.commit();
+			}
+
+			for (auto& p : edges._edges) {
+				out << "    <edge id=\"e" << p.first << "\" source=\"n" << p.second._from->_id
+					<< "\" target=\"n" << p.second._to->_id << "\"><data key=\"e\">";
+				std::size_t value = out.size();
+				edge_format(out, p.second._element);
+				out.escape(value, output_buffer::xml_text);
+				out << "</data></edge>\n";
+				out.commit();
+			}
+
+			out << "  </graph>\n</graphml>\n";
+		}
+
+		/*! @brief writes one line "from to value" per edge to *os*
+		 *  @details Vertices are given by their ids and the value is the text *edge_format*
+		 *           appends, which is left out with its separator if it is empty. The output of
+		 *           the default formatter for numeric edge types can be read by
+		 *           plexum::read_edge_list().
+		 */
+		template<typename EF = default_format>
+		void write_edge_list(std::ostream& os, EF edge_format = EF())
+		{
+			output_buffer out(os);
+
+			for (auto& p : edges._edges) {
+				out << p.second._from->_id << ' ' << p.second._to->_id << ' ';
+				std::size_t value = out.size();
+				edge_format(out, p.second._element);
+
+				if (out.size() == value)
+					out.truncate(value - 1);
+
+				out << '\n';
+				out.commit();
+			}
+		}
+
+		/*! @brief writes a snapshot of the graph to the binary file at *path*
+		 *  @details equivalent to freeze(threads).save(path), see csr_graph::save() for the
+		 *           format and csr_graph::open() for loading it
+		 */
+		void write_binary(const std::string& path, unsigned threads = 0)
+		{
+			freeze(threads).save(path);
+		}
+
+		// T, U, S, D in order not to shadow VertexType, EdgeType, Storage, Direction
+		template<class T, class U, template<class> class S, class D>
+		friend std::ostream& operator<<(std::ostream& os, Graph<T, U, S, D>& g);
+
+		/*! @brief the vertex_proxy holding the graph's vertices */
+		vertex_proxy vertices;
+
+		/*! @brief the edge_proxy holding the graph's edges */
+		edge_proxy edges;
+
+	private:
+
+		static bool _any_edge(EdgeType*)
+		{
+			return true;
+		}
+
+		// the list holding the side 1 entries of the edges at *v*, the incidence list of
+		// undirected graphs and the in-adjacency of bidirectional ones
+		static inline _adjacency_list& _incoming(vertex_container<VertexType>* v, undirected)
+		{
+			return v->_neighbors;
+		}
+
+		static inline _adjacency_list& _incoming(vertex_container<VertexType>* v, bidirectional)
+		{
+			return v->_in_neighbors;
+		}
+
+		static inline _adjacency_list& _incoming(vertex_container<VertexType>* v, directed)
+		{
+			static_assert(!std::is_same<Direction, directed>::value,
+						  "plexum::directed graphs do not store incoming edges, "
+						  "use plexum::bidirectional");
+			return v->_neighbors;
+		}
+
+		static inline std::size_t _in_degree(vertex_container<VertexType>* v, undirected)
+		{
+			return v->_neighbors.size();
+		}
+
+		static inline std::size_t _in_degree(vertex_container<VertexType>* v, directed)
+		{
+			return v->_in_degree;
+		}
+
+		static inline std::size_t _in_degree(vertex_container<VertexType>* v, bidirectional)
+		{
+			return v->_in_neighbors.size();
+		}
+
+		// the entries a search expands at *v*, the incoming ones when searching from the target
+		static inline _adjacency_list& _expand(vertex_container<VertexType>* v, std::false_type)
+		{
+			return v->_neighbors;
+		}
+
+		static inline _adjacency_list& _expand(vertex_container<VertexType>* v, std::true_type)
+		{
+			return _incoming(v, Direction());
+		}
+
+		// breadth-first search from *start* until *target* is discovered, recording the parent edge
+		// of every discovered vertex in *ws*. Returns whether *target* was reached.
+		template<typename F>
+		bool _bfs(vertex_container<VertexType>* start, vertex_container<VertexType>* target,
+				  F cstr, search_workspace& ws)
+		{
+			ws._reset(vertices._vertices.bound());
+			ws._visit(vertex_storage::index(start->_id), nullptr);
+
+			if (start == target)
+				return true;
+
+			// every vertex enters the frontier at most once, so the frontier never wraps around
+			std::size_t head = 0, tail = 0;
+			ws._frontier[tail++] = start;
+
+			while (head != tail) {
+				vertex_container<VertexType>* c = ws._frontier[head++];
+				ws._expanded++;
+
+				for (auto& a : c->_neighbors) {
+					std::size_t i = vertex_storage::index(a.vertex->_id);
+
+					if (!ws._is_visited(i) && cstr(&(a.edge->_element))) {
+						ws._visit(i, a.edge);
+
+						if (a.vertex == target)
+							return true;
+
+						ws._frontier[tail++] = a.vertex;
+					}
+				}
+			}
+
+			return false;
+		}
+
+		// Dijkstra's algorithm from *start* until *target* is settled, recording the parent edge
+		// and distance of every reached vertex in *ws*. Returns whether *target* was reached.
+		// A *Backward* search follows edges against their direction.
+		template<bool Backward = false, typename W, typename F>
+		bool _dijkstra(vertex_container<VertexType>* start, vertex_container<VertexType>* target,
+					   W weight, F cstr, search_workspace& ws)
+		{
+			ws._reset_weighted(vertices._vertices.bound());
+
+			std::size_t s = vertex_storage::index(start->_id);
+			ws._visit(s, nullptr);
+			ws._distance[s] = 0;
+			ws._vertex[s] = start;
+			ws._heap.push(s, 0);
+
+			while (!ws._heap.empty()) {
+				double d = ws._heap.top_key();
+				vertex_container<VertexType>* c = ws._vertex[ws._heap.pop()];
+				ws._expanded++;
+
+				if (c == target)
+					return true;
+
+				for (auto& a : _expand(c, std::integral_constant<bool, Backward>())) {
+					std::size_t i = vertex_storage::index(a.vertex->_id);
+					bool reached = ws._is_visited(i);
+
+					if ((reached && !ws._heap.contains(i)) || !cstr(&(a.edge->_element)))
+						continue;
+
+					double w = weight(&(a.edge->_element));
+
+					if (w < 0)
+						throw exception("Graph::shortest_path(): negative edge weight");
+
+					if (!reached) {
+						ws._visit(i, a.edge);
+						ws._distance[i] = d + w;
+						ws._vertex[i] = a.vertex;
+						ws._heap.push(i, d + w);
+					} else if (d + w < ws._distance[i]) {
+						ws._parent[i] = a.edge;
+						ws._distance[i] = d + w;
+						ws._heap.decrease(i, d + w);
+					}
+				}
+			}
+
+			return false;
+		}
+
+		// A* search from *start* to *target* ordered by distance plus the landmark lower bound
+		template<typename W, typename F>
+		bool _astar(vertex_container<VertexType>* start, vertex_container<VertexType>* target,
+					W weight, F cstr, const alt_landmarks& lm, search_workspace& ws)
+		{
+			std::size_t t = vertex_storage::index(target->_id);
+
+			return _best_first(start, target, weight,
+				[&cstr](const typename vertex_container<VertexType>::adjacency& a) {
+					return cstr(&(a.edge->_element));
+				},
+				[&lm, t, target](std::size_t i, vertex_container<VertexType>* v) {
+					return lm._lower_bound(i, v->_id, t, target->_id);
+				},
+				ws);
+		}
+
+		// best-first search from *start* to *target* ordered by distance plus *bound*, a consistent
+		// lower bound on the remaining distance to *target*. Only adjacency entries accepted by
+		// *admit* are followed. Returns whether *target* was reached.
+		template<typename W, typename A, typename H>
+		bool _best_first(vertex_container<VertexType>* start, vertex_container<VertexType>* target,
+						 W weight, A admit, H bound, search_workspace& ws)
+		{
+			ws._reset_weighted(vertices._vertices.bound());
+
+			std::size_t s = vertex_storage::index(start->_id);
+			ws._visit(s, nullptr);
+			ws._distance[s] = 0;
+			ws._vertex[s] = start;
+			ws._heap.push(s, bound(s, start));
+
+			while (!ws._heap.empty()) {
+				std::size_t ci = ws._heap.pop();
+				vertex_container<VertexType>* c = ws._vertex[ci];
+				double d = ws._distance[ci];
+				ws._expanded++;
 
 				if (c == target)
-					break;
+					return true;
+
+				for (auto& a : c->_neighbors) {
+					std::size_t i = vertex_storage::index(a.vertex->_id);
+					bool reached = ws._is_visited(i);
+
+					if ((reached && !ws._heap.contains(i)) || !admit(a))
+						continue;
+
+					double w = weight(&(a.edge->_element));
+
+					if (w < 0)
+						throw exception("Graph::shortest_path(): negative edge weight");
+
+					if (!reached) {
+						ws._visit(i, a.edge);
+						ws._distance[i] = d + w;
+						ws._vertex[i] = a.vertex;
+						ws._heap.push(i, d + w + bound(i, a.vertex));
+					} else if (d + w < ws._distance[i]) {
+						ws._parent[i] = a.edge;
+						ws._distance[i] = d + w;
+						ws._heap.decrease(i, d + w + bound(i, a.vertex));
+					}
+				}
+			}
+
+			return false;
+		}
+
+		// where the two halves of a bidirectional search meet: *edge* connects *forward*, reached
+		// from the start, and *backward*, reached from the target
+		struct _meeting
+		{
+			vertex_container<VertexType>* forward;
+			edge_container<EdgeType>* edge;
+			vertex_container<VertexType>* backward;
+		};
+
+		// level-synchronous breadth-first search from both *start* and *target*, always expanding
+		// the smaller frontier. Levels are completed before stopping, so the shortest of the
+		// connections found in the first level that meets the other search is a shortest path.
+		template<typename F>
+		_meeting _bidirectional_bfs(vertex_container<VertexType>* start,
+									vertex_container<VertexType>* target,
+									F cstr, search_workspace& ws)
+		{
+			search_workspace* side[2] = { &ws, &ws._backward() };
+			vertex_container<VertexType>* root[2] = { start, target };
+			std::size_t head[2] = { 0, 0 }, tail[2] = { 1, 1 };
+			std::size_t bound = vertices._vertices.bound();
+			_meeting m = { start, nullptr, target };
+			double best = std::numeric_limits<double>::infinity();
+
+			for (int x = 0; x < 2; x++) {
+				side[x]->_reset_weighted(bound);
+				side[x]->_visit(vertex_storage::index(root[x]->_id), nullptr);
+				side[x]->_distance[vertex_storage::index(root[x]->_id)] = 0;
+				side[x]->_frontier[0] = root[x];
+			}
+
+			if (start == target)
+				return m;
+
+			while (head[0] != tail[0] && head[1] != tail[1]) {
+				int x = (tail[0] - head[0] <= tail[1] - head[1]) ? 0 : 1;
+				search_workspace& X = *side[x];
+				search_workspace& Y = *side[1 - x];
+				std::size_t level_end = tail[x];
 
-				std::vector<typename vertex_proxy::iterator> neighbors = vertices[c].neighbors();
+				while (head[x] != level_end) {
+					vertex_container<VertexType>* c = X._frontier[head[x]++];
+					double d = X._distance[vertex_storage::index(c->_id)] + 1;
+					X._expanded++;
 
-				for (typename vertex_proxy::iterator i : neighbors) {
-					auto e = edges.between(c_iter, i);
+					for (auto& a : x == 0 ? c->_neighbors : _incoming(c, Direction())) {
+						std::size_t i = vertex_storage::index(a.vertex->_id);
+						bool reached = X._is_visited(i);
 
-					if (visited[i.id()] < 0) {
-						if (cstr(&(*e))) {
-							visited[i.id()] = c;
-							queue.push_back(i.id());
+						if ((reached && !Y._is_visited(i)) || !cstr(&(a.edge->_element)))
+							continue;
+
+						if (Y._is_visited(i) && d + Y._distance[i] < best) {
+							best = d + Y._distance[i];
+							m = x == 0 ? _meeting{ c, a.edge, a.vertex } : _meeting{ a.vertex, a.edge, c };
+						}
+
+						if (!reached) {
+							X._visit(i, a.edge);
+							X._distance[i] = d;
+							X._frontier[tail[x]++] = a.vertex;
 						}
 					}
 				}
+
+				if (m.edge)
+					return m;
+			}
+
+			throw exception("there is no path between the specified vertices");
+		}
+
+		// Dijkstra searches from both *start* and *target*, advancing the one with the smaller
+		// tentative distance, until no connection shorter than the best one found can remain
+		template<typename W, typename F>
+		_meeting _bidirectional_dijkstra(vertex_container<VertexType>* start,
+										 vertex_container<VertexType>* target,
+										 W weight, F cstr, search_workspace& ws)
+		{
+			search_workspace* side[2] = { &ws, &ws._backward() };
+			vertex_container<VertexType>* root[2] = { start, target };
+			std::size_t bound = vertices._vertices.bound();
+			_meeting m = { start, nullptr, target };
+			double best = std::numeric_limits<double>::infinity();
+
+			for (int x = 0; x < 2; x++) {
+				std::size_t r = vertex_storage::index(root[x]->_id);
+				side[x]->_reset_weighted(bound);
+				side[x]->_visit(r, nullptr);
+				side[x]->_distance[r] = 0;
+				side[x]->_vertex[r] = root[x];
+				side[x]->_heap.push(r, 0);
+			}
+
+			if (start == target)
+				return m;
+
+			while (!side[0]->_heap.empty() && !side[1]->_heap.empty()
+				   && side[0]->_heap.top_key() + side[1]->_heap.top_key() < best) {
+				int x = side[0]->_heap.top_key() <= side[1]->_heap.top_key() ? 0 : 1;
+				search_workspace& X = *side[x];
+				search_workspace& Y = *side[1 - x];
+				double d = X._heap.top_key();
+				vertex_container<VertexType>* c = X._vertex[X._heap.pop()];
+				X._expanded++;
+
+				for (auto& a : x == 0 ? c->_neighbors : _incoming(c, Direction())) {
+					std::size_t i = vertex_storage::index(a.vertex->_id);
+					bool reached = X._is_visited(i);
+
+					if (!cstr(&(a.edge->_element)))
+						continue;
+
+					double w = weight(&(a.edge->_element));
+
+					if (w < 0)
+						throw exception("Graph::shortest_path(): negative edge weight");
+
+					if (Y._is_visited(i) && d + w + Y._distance[i] < best) {
+						best = d + w + Y._distance[i];
+						m = x == 0 ? _meeting{ c, a.edge, a.vertex } : _meeting{ a.vertex, a.edge, c };
+					}
+
+					if (reached && !X._heap.contains(i))
+						continue;
+
+					if (!reached) {
+						X._visit(i, a.edge);
+						X._distance[i] = d + w;
+						X._vertex[i] = a.vertex;
+						X._heap.push(i, d + w);
+					} else if (d + w < X._distance[i]) {
+						X._parent[i] = a.edge;
+						X._distance[i] = d + w;
+						X._heap.decrease(i, d + w);
+					}
+				}
+			}
+
+			if (!m.edge)
+				throw exception("there is no path between the specified vertices");
+
+			return m;
+		}
+
+		// joins the two halves of a bidirectional search at the meeting edge
+		std::vector<typename edge_proxy::iterator> _trace_path(vertex_container<VertexType>* start,
+															   vertex_container<VertexType>* target,
+															   const _meeting& m,
+															   search_workspace& ws)
+		{
+			std::vector<typename edge_proxy::iterator> path;
+
+			if (!m.edge)
+				return path;
+
+			path = _trace_path(start, m.forward, ws);
+			path.push_back(typename edge_proxy::iterator(this, edges._edges.find(m.edge->_id)));
+
+			std::vector<typename edge_proxy::iterator> back = _trace_path(target, m.backward,
+																		  ws._backward());
+			path.insert(path.end(), back.rbegin(), back.rend());
+			return path;
+		}
+
+		// follows the parent edges recorded in *ws* from *target* back to *start*
+		std::vector<typename edge_proxy::iterator> _trace_path(vertex_container<VertexType>* start,
+															   vertex_container<VertexType>* target,
+															   search_workspace& ws)
+		{
+			std::vector<typename edge_proxy::iterator> path;
+			vertex_container<VertexType>* v = target;
+
+			while (v != start) {
+				edge_container<EdgeType>* e = ws._parent[vertex_storage::index(v->_id)];
+				path.push_back(typename edge_proxy::iterator(this, edges._edges.find(e->_id)));
+				v = e->_from == v ? e->_to : e->_from;
+			}
+
+			std::reverse(path.begin(), path.end());
+			return path;
+		}
+
+		// merges the components of *a* and *b* if the connectivity index is maintained
+		inline void _join(vertex_container<VertexType>* a, vertex_container<VertexType>* b)
+		{
+			if (_tracking_components && !_components_stale)
+				_merges += _components.unite(vertex_storage::index(a->_id),
+											 vertex_storage::index(b->_id));
+		}
+
+		// rebuilds the connectivity index if it is stale and maintains it from now on
+		void _refresh_components()
+		{
+			_tracking_components = true;
+
+			if (!_components_stale)
+				return;
+
+			_components.clear();
+			_merges = 0;
+
+			for (auto& p : edges._edges)
+				_merges += _components.unite(vertex_storage::index(p.second._from->_id),
+											 vertex_storage::index(p.second._to->_id));
+
+			_components_stale = false;
+		}
+
+		// checks whether the current connectivity index proves that there is no path between
+		// *a* and *b*; does not modify the index, so concurrent searches may call it
+		inline bool _separated(vertex_container<VertexType>* a, vertex_container<VertexType>* b) const
+		{
+			return _tracking_components && !_components_stale
+				&& _components.root(vertex_storage::index(a->_id))
+				!= _components.root(vertex_storage::index(b->_id));
+		}
+
+		// records added edges, which may shorten any path
+		inline void _grown()
+		{
+			_version++;
+			_additions++;
+		}
+
+		// records removed edges, which only break the paths running over them
+		inline void _shrunk()
+		{
+			_version++;
+			_removals++;
+		}
+
+		// a cached find_path() result and the edge counters it was computed at
+		struct _cached_path
+		{
+			std::size_t additions;
+			std::size_t removals;
+			std::vector<std::size_t> ids;
+			std::vector<typename edge_proxy::iterator> path;
+		};
+
+		struct _path_key
+		{
+			std::size_t start;
+			std::size_t target;
+			std::size_t tag;
+
+			inline bool operator==(const _path_key& other) const
+			{
+				return start == other.start && target == other.target && tag == other.tag;
+			}
+		};
+
+		struct _path_key_hash
+		{
+			inline std::size_t operator()(const _path_key& k) const
+			{
+				std::size_t h = k.start * 0x9e3779b97f4a7c15ULL;
+				h = (h ^ k.target) * 0x9e3779b97f4a7c15ULL;
+				return (h ^ k.tag) * 0x9e3779b97f4a7c15ULL;
+			}
+		};
+
+		// checks whether *c* is still a shortest path: no edge was added since it was computed,
+		// and if edges were removed, all of its edges are still there
+		bool _revalidate(_cached_path& c)
+		{
+			if (c.additions != _additions)
+				return false;
+
+			if (c.removals != _removals) {
+				for (std::size_t id : c.ids)
+					if (edges._edges.find(id) == edges._edges.end())
+						return false;
+
+				c.removals = _removals;
+			}
+
+			return true;
+		}
+
+		// the residual capacities and routing trees of embed(), indexed by storage index
+		struct _embedding_state
+		{
+			_embedding_state(std::size_t vertex_bound, std::size_t edge_bound)
+				: substrate(vertex_bound, nullptr),
+				  vertex_residual(vertex_bound, 0),
+				  hosting(vertex_bound, false),
+				  edge_residual(edge_bound, 0),
+				  trees(),
+				  queue()
+			{
+				queue.reserve(vertex_bound);
+			}
+
+			// a breadth-first tree over the edges that had at least *demand* residual capacity
+			struct tree
+			{
+				double demand;
+				std::vector<edge_container<EdgeType>*> parent;
+			};
+
+			std::vector<vertex_container<VertexType>*> substrate;
+			std::vector<double> vertex_residual;
+			std::vector<bool> hosting;
+			std::vector<double> edge_residual;
+			std::map<std::size_t, tree> trees;
+			std::vector<std::size_t> queue;
+		};
+
+		struct _by_decreasing_demand
+		{
+			template<class T>
+			inline bool operator()(const T& a, const T& b) const
+			{
+				return std::get<0>(a) > std::get<0>(b);
 			}
-			return visited;
 		};
 
+		// appends the edges of a path from substrate vertex *s* to *t* with at least *d* residual
+		// capacity to *route*, reusing the tree of *s* if its path still fits
+		bool _route(_embedding_state& st, std::size_t s, std::size_t t, double d,
+					std::vector<edge_container<EdgeType>*>& route)
+		{
+			auto cached = st.trees.find(s);
+
+			// a tree built for a higher demand may miss shorter paths over edges it excluded,
+			// while one built for *d* stays shortest as residual capacities only shrink
+			if (cached != st.trees.end() && cached->second.demand == d
+				&& _trace(st, cached->second, s, t, d, route))
+				return true;
+
+			typename _embedding_state::tree& tr = st.trees[s];
+			tr.demand = d;
+			tr.parent.assign(st.substrate.size(), nullptr);
+
+			std::vector<bool> seen(st.substrate.size(), false);
+			st.queue.assign(1, s);
+			seen[s] = true;
+
+			for (std::size_t head = 0; head < st.queue.size(); head++) {
+				for (auto& a : st.substrate[st.queue[head]]->_neighbors) {
+					std::size_t i = vertex_storage::index(a.vertex->_id);
+
+					if (!seen[i] && st.edge_residual[edge_storage::index(a.edge->_id)] >= d) {
+						seen[i] = true;
+						tr.parent[i] = a.edge;
+						st.queue.push_back(i);
+					}
+				}
+			}
+
+			return seen[t] && _trace(st, tr, s, t, d, route);
+		}
+
+		// appends the path from *s* to *t* in *tr* to *route* if it has *d* residual capacity
+		bool _trace(_embedding_state& st, const typename _embedding_state::tree& tr,
+					std::size_t s, std::size_t t, double d,
+					std::vector<edge_container<EdgeType>*>& route)
+		{
+			std::size_t first = route.size();
+
+			for (std::size_t v = t; v != s; ) {
+				edge_container<EdgeType>* e = tr.parent[v];
+
+				if (e == nullptr || st.edge_residual[edge_storage::index(e->_id)] < d) {
+					route.resize(first);
+					return false;
+				}
+
+				route.push_back(e);
+				std::size_t from = vertex_storage::index(e->_from->_id);
+				v = from == v ? vertex_storage::index(e->_to->_id) : from;
+			}
+
+			std::reverse(route.begin() + first, route.end());
+			return true;
+		}
+
+		// the values are written through *os*, so its precision and flags apply
 		void _print_adjacency_list(std::ostream& os)
 		{
-			for(std::pair<std::size_t, vertex_container<VertexType>> p : vertices._vertices) {
+			for (auto& p : vertices._vertices) {
+				auto& neighbors = p.second._neighbors;
+
 				os << " " << p.second._element << " -> [ ";
-				for(unsigned i = 0; i < p.second._neighbors.size(); i++) {
-					os << p.second._neighbors[i]->_element
-					<< (i == p.second._neighbors.size()-2 ? ", " : " ");
+				for (std::size_t i = 0; i < neighbors.size(); i++) {
+					os << neighbors[i].vertex->_element
+					   << (i + 1 < neighbors.size() ? ", " : " ");
 				}
-				os << "]" << std::endl;
+				os << "]\n";
 			}
 		}
 
-		Graph<VertexType, EdgeType>* _supergraph;
+		Graph<VertexType, EdgeType, Storage, Direction>* _supergraph;
+
+		// the position of the graph in the subgraphs of _supergraph
+		std::size_t _subgraph_position;
+
+		std::vector<Graph<VertexType, EdgeType, Storage, Direction>*> _subgraphs;
+
+		std::function<double(const VertexType&)> _vertex_demand;
+		std::function<double(const EdgeType&)> _edge_demand;
+
+		search_workspace _workspace;
+
+		memory_resource* _resource;
+
+		// the weakly connected components, by storage index, maintained once connected() or
+		// component() was called and rebuilt lazily after removals
+		bool _tracking_components;
+		bool _components_stale;
+		union_find _components;
+		std::size_t _merges;
+
+		// the mutation counters, see version() and enable_path_cache()
+		std::size_t _version;
+		std::size_t _additions;
+		std::size_t _removals;
 
-		std::vector<Graph<VertexType, EdgeType>*> _subgraphs;
+		lru_cache<_path_key, _cached_path, _path_key_hash> _path_cache;
+		path_cache_stats _path_cache_stats;
 	};
 
-	template<class VertexType, class EdgeType>
-	std::ostream& operator<<(std::ostream& os, Graph<VertexType, EdgeType>& g)
+	template<class VertexType, class EdgeType, template<class> class Storage, class Direction>
+	std::ostream& operator<<(std::ostream& os, Graph<VertexType, EdgeType, Storage, Direction>& g)
 	{
-		os << "Graph(n=" << g.vertices.count() << ", m=" << g.edges.count() << ")"
-		<<  std::endl;
+		os << "Graph(n=" << g.vertices.count() << ", m=" << g.edges.count() << ")\n";
 		g._print_adjacency_list(os);
 		return os;
 	};
@@ -0,0 +1,297 @@
+/*
+ * plexum graph library
+ *
+ * oliver dot michel at colorado dot edu
+ *
+ * MIT License
+ */
+
+#ifndef PLEXUM_GRAPH_BUILDER_H
+#define PLEXUM_GRAPH_BUILDER_H
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <plexum/exception.h>
+#include <plexum/graph.h>
+#include <plexum/parallel.h>
+
+namespace plexum
+{
+	//
+	// plexum::graph_builder<VertexType, EdgeType, Storage, Direction>
+	//
+
+	/*! @brief Collects vertices and edges from many threads at once and adds them to a Graph in
+	 *         a single parallel merge.
+	 *  @details Every thread obtains its own shard and records vertices and edges in it without
+	 *           synchronizing with other threads. A vertex recorded in a shard is identified by a
+	 *           ticket until it is merged. Tickets are unique across all shards: every shard
+	 *           reserves them in blocks of TICKET_BLOCK from an atomic counter. Edges connect
+	 *           tickets, and shard::vertex() hands out a ticket for a vertex already in the
+	 *           graph.
+	 *
+	 *           commit() adds the recorded vertices through vertices.add_range(), translates the
+	 *           edges of all shards to vertex ids in parallel and adds them through a single call
+	 *           to edges.add_range(). With plexum::slot_storage both construct their elements and
+	 *           fill the adjacency lists on multiple threads, while counting the entries of each
+	 *           list and growing the lists stay serial; for random edges that is about a third
+	 *           of the merge. The graph is not touched before commit(), so it may be read while
+	 *           shards are filled. commit() must not run while any shard is in use.
+	 *  @tparam VertexType the vertex type
+	 *  @tparam EdgeType the edge type
+	 *  @tparam Storage the storage backend of the graph, see plexum::Graph
+	 *  @tparam Direction the direction policy of the graph, see plexum::Graph
+	 */
+	template<class VertexType, class EdgeType, template<class> class Storage = map_storage,
+			 class Direction = undirected>
+	class graph_builder
+	{
+	public:
+
+		typedef Graph<VertexType, EdgeType, Storage, Direction> graph_type;
+
+		/*! @brief the number of tickets a shard reserves at once */
+		static const std::size_t TICKET_BLOCK = 1024;
+
+		/*! @brief marks tickets not standing for a vertex in the return value of commit() */
+		static const std::size_t npos = static_cast<std::size_t>(-1);
+
+		//
+		// plexum::graph_builder<VertexType, EdgeType, Storage, Direction>::shard
+		//
+
+		/*! @brief The vertices and edges recorded by a single thread. */
+		class shard
+		{
+			friend class graph_builder<VertexType, EdgeType, Storage, Direction>;
+
+		public:
+
+			shard(const shard&) = delete;
+			shard& operator=(const shard&) = delete;
+
+			/*! @brief records a new vertex
+			 *  @return the ticket of the vertex
+			 */
+			std::size_t add_vertex(const VertexType& vertex)
+			{
+				std::size_t t = _ticket();
+				_vertices.emplace_back(t, vertex);
+				return t;
+			}
+
+			/*! @brief returns a ticket standing for the vertex with *id* in the graph
+			 *  @details the vertex must still exist when commit() is called
+			 */
+			std::size_t vertex(std::size_t id)
+			{
+				std::size_t t = _ticket();
+				_bindings.emplace_back(t, id);
+				return t;
+			}
+
+			/*! @brief records an edge between the vertices with tickets *from* and *to*, which
+			 *         may have been handed out by any shard of the builder
+			 */
+			void add_edge(std::size_t from, std::size_t to, const EdgeType& edge)
+			{
+				_edges.emplace_back(from, to, edge);
+			}
+
+			/*! @brief returns the number of vertices recorded since the last commit() */
+			inline std::size_t vertex_count() const
+			{
+				return _vertices.size();
+			}
+
+			/*! @brief returns the number of edges recorded since the last commit() */
+			inline std::size_t edge_count() const
+			{
+				return _edges.size();
+			}
+
+		private:
+
+			explicit shard(graph_builder* builder)
+				: _builder(builder),
+				  _next(0),
+				  _end(0),
+				  _vertices(),
+				  _bindings(),
+				  _edges()
+			{ }
+
+			inline std::size_t _ticket()
+			{
+				if (_next == _end) {
+					_next = _builder->_tickets.fetch_add(TICKET_BLOCK, std::memory_order_relaxed);
+					_end = _next + TICKET_BLOCK;
+				}
+
+				return _next++;
+			}
+
+			void _clear()
+			{
+				_next = _end = 0;
+				std::vector<std::pair<std::size_t, VertexType>>().swap(_vertices);
+				std::vector<std::pair<std::size_t, std::size_t>>().swap(_bindings);
+				std::vector<std::tuple<std::size_t, std::size_t, EdgeType>>().swap(_edges);
+			}
+
+			graph_builder* _builder;
+
+			// the remaining tickets of the current block
+			std::size_t _next;
+			std::size_t _end;
+
+			std::vector<std::pair<std::size_t, VertexType>> _vertices;
+			std::vector<std::pair<std::size_t, std::size_t>> _bindings;
+			std::vector<std::tuple<std::size_t, std::size_t, EdgeType>> _edges;
+		};
+
+		/*! @brief constructs a builder adding to *g* */
+		explicit graph_builder(graph_type& g)
+			: _graph(g),
+			  _tickets(0),
+			  _shards(),
+			  _mutex()
+		{ }
+
+		graph_builder(const graph_builder&) = delete;
+		graph_builder& operator=(const graph_builder&) = delete;
+
+		/*! @brief returns a new shard, to be used by a single thread at a time
+		 *  @details may be called from any thread; the shard lives as long as the builder and
+		 *           may be reused after commit()
+		 */
+		shard& make_shard()
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_shards.emplace_back(new shard(this));
+			return *_shards.back();
+		}
+
+		/*! @brief adds the vertices and edges recorded in all shards to the graph and empties
+		 *         the shards, invalidating all tickets
+		 *  @param threads the number of threads constructing the vertices and edges, translating
+		 *         the edges and filling the adjacency lists (0 selects one per hardware thread),
+		 *         see Graph::edge_proxy::add_range()
+		 *  @return the id of the vertex each ticket stood for, indexed by ticket, and npos for
+		 *          tickets never handed out
+		 *  @throws exception if an edge refers to a ticket never handed out or a shard refers to
+		 *          a vertex not in the graph, in which case the graph and the shards are left
+		 *          unchanged. If constructing a vertex or edge throws, the vertices added so far
+		 *          are removed again and the shards keep their contents, so commit() may be
+		 *          retried.
+		 */
+		std::vector<std::size_t> commit(unsigned threads = 0)
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+
+			static const std::size_t pending = npos - 1;
+
+			std::vector<std::size_t> ids(_tickets.load(std::memory_order_relaxed), npos);
+			std::vector<VertexType> values;
+			std::size_t m = 0;
+
+			for (auto& s : _shards) {
+				for (auto& b : s->_bindings) {
+					if (!_graph.vertices.has_index(b.second))
+						throw exception("graph_builder::commit(): vertex "
+										+ std::to_string(b.second) + " does not exist.");
+					ids[b.first] = b.second;
+				}
+
+				for (auto& v : s->_vertices)
+					ids[v.first] = pending;
+
+				m += s->_edges.size();
+			}
+
+			for (auto& s : _shards)
+				for (auto& e : s->_edges)
+					if (!_issued(ids, std::get<0>(e)) || !_issued(ids, std::get<1>(e)))
+						throw exception("graph_builder::commit(): unknown ticket "
+										+ std::to_string(_issued(ids, std::get<0>(e))
+														 ? std::get<1>(e) : std::get<0>(e))
+										+ ".");
+
+			for (auto& s : _shards)
+				for (auto& v : s->_vertices)
+					values.push_back(v.second);
+
+			std::vector<std::size_t> added = _graph.vertices.add_range(values.begin(),
+																	   values.end(), threads);
+
+			// the shards are only emptied once all edges have been added
+			try {
+				std::vector<std::tuple<std::size_t, std::size_t, EdgeType>> edges;
+				std::vector<std::size_t> offsets;
+				std::size_t k = 0;
+
+				for (auto& s : _shards)
+					for (auto& v : s->_vertices)
+						ids[v.first] = added[k++];
+
+				edges.reserve(m);
+
+				for (auto& s : _shards) {
+					offsets.push_back(edges.size());
+					edges.insert(edges.end(), s->_edges.begin(), s->_edges.end());
+				}
+
+				// the edges are copied before they are translated, so the edge type need not be
+				// default constructible
+				parallel_for_each(0, _shards.size(), threads, [&](std::size_t i, unsigned) {
+					for (std::size_t j = 0; j < _shards[i]->_edges.size(); j++) {
+						auto& e = edges[offsets[i] + j];
+						std::get<0>(e) = ids[std::get<0>(e)];
+						std::get<1>(e) = ids[std::get<1>(e)];
+					}
+				});
+
+				_graph.edges.add_range(edges.begin(), edges.end(), threads);
+			} catch (...) {
+				for (std::size_t id : added)
+					_graph.vertices.remove(_graph.vertices[id]);
+				throw;
+			}
+
+			for (auto& s : _shards)
+				s->_clear();
+
+			_tickets.store(0, std::memory_order_relaxed);
+			return ids;
+		}
+
+	private:
+
+		static inline bool _issued(const std::vector<std::size_t>& ids, std::size_t t)
+		{
+			return t < ids.size() && ids[t] != npos;
+		}
+
+		graph_type& _graph;
+
+		std::atomic<std::size_t> _tickets;
+		std::vector<std::unique_ptr<shard>> _shards;
+		std::mutex _mutex;
+	};
+
+	template<class VertexType, class EdgeType, template<class> class Storage, class Direction>
+	const std::size_t graph_builder<VertexType, EdgeType, Storage, Direction>::TICKET_BLOCK;
+
+	template<class VertexType, class EdgeType, template<class> class Storage, class Direction>
+	const std::size_t graph_builder<VertexType, EdgeType, Storage, Direction>::npos;
+}
+
+#endif
@@ -0,0 +1,202 @@
+/*
+ * plexum graph library
+ *
+ * oliver dot michel at colorado dot edu
+ *
+ * MIT License
+ */
+
+#ifndef PLEXUM_HEAP_H
+#define PLEXUM_HEAP_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace plexum
+{
+	//
+	// plexum::indexed_heap<Key, D>
+	//
+
+	/*! @brief An addressable d-ary min-heap over the integers [0, n).
+	 *  @details Tracks the heap position of every item, so the key of a queued item can be
+	 *           decreased in O(log_D n). A wider fan-out than a binary heap makes the heap
+	 *           shallower and keeps siblings in the same cache line, which pays off for the
+	 *           many decrease-key operations of shortest path searches. clear() only touches
+	 *           items still queued, so a heap can be reused across searches without O(n) resets.
+	 *  @tparam Key the key type
+	 *  @tparam D the number of children per node
+	 */
+	template<class Key, unsigned D = 4>
+	class indexed_heap
+	{
+		static_assert(D >= 2, "indexed_heap requires a fan-out of at least 2");
+
+	public:
+
+		/*! @brief marks items that are not queued */
+		static const std::size_t npos = static_cast<std::size_t>(-1);
+
+		indexed_heap()
+			: _heap(),
+			  _position()
+		{ }
+
+		/*! @brief empties the heap and makes room for the items [0, n) */
+		void reset(std::size_t n)
+		{
+			clear();
+
+			if (_position.size() < n)
+				_position.resize(n, npos);
+		}
+
+		/*! @brief removes all queued items */
+		void clear()
+		{
+			for (auto& entry : _heap)
+				_position[entry.second] = npos;
+
+			_heap.clear();
+		}
+
+		inline bool empty() const
+		{
+			return _heap.empty();
+		}
+
+		inline std::size_t size() const
+		{
+			return _heap.size();
+		}
+
+		/*! @brief checks whether *item* is queued */
+		inline bool contains(std::size_t item) const
+		{
+			return _position[item] != npos;
+		}
+
+		/*! @brief returns the smallest key in the heap */
+		inline const Key& top_key() const
+		{
+			return _heap.front().first;
+		}
+
+		/*! @brief returns the item with the smallest key in the heap */
+		inline std::size_t top() const
+		{
+			return _heap.front().second;
+		}
+
+		/*! @brief queues *item* with *key* */
+		void push(std::size_t item, const Key& key)
+		{
+			_heap.push_back(std::make_pair(key, item));
+			_position[item] = _heap.size() - 1;
+			_sift_up(_heap.size() - 1);
+		}
+
+		/*! @brief lowers the key of the queued *item* to *key* */
+		void decrease(std::size_t item, const Key& key)
+		{
+			std::size_t i = _position[item];
+			_heap[i].first = key;
+			_sift_up(i);
+		}
+
+		/*! @brief queues *item* with *key* or lowers its key if it is queued with a larger one
+		 *  @return true if the item was queued or its key was lowered
+		 */
+		bool push_or_decrease(std::size_t item, const Key& key)
+		{
+			if (!contains(item)) {
+				push(item, key);
+				return true;
+			}
+
+			if (key < _heap[_position[item]].first) {
+				decrease(item, key);
+				return true;
+			}
+
+			return false;
+		}
+
+		/*! @brief removes and returns the item with the smallest key */
+		std::size_t pop()
+		{
+			std::size_t item = _heap.front().second;
+			_position[item] = npos;
+
+			if (_heap.size() > 1) {
+				_heap.front() = _heap.back();
+				_position[_heap.front().second] = 0;
+				_heap.pop_back();
+				_sift_down(0);
+			} else {
+				_heap.pop_back();
+			}
+
+			return item;
+		}
+
+	private:
+
+		void _sift_up(std::size_t i)
+		{
+			std::pair<Key, std::size_t> entry = _heap[i];
+
+			while (i > 0) {
+				std::size_t parent = (i - 1) / D;
+
+				if (!(entry.first < _heap[parent].first))
+					break;
+
+				_heap[i] = _heap[parent];
+				_position[_heap[i].second] = i;
+				i = parent;
+			}
+
+			_heap[i] = entry;
+			_position[entry.second] = i;
+		}
+
+		void _sift_down(std::size_t i)
+		{
+			std::pair<Key, std::size_t> entry = _heap[i];
+			std::size_t n = _heap.size();
+
+			for (;;) {
+				std::size_t first = D * i + 1;
+
+				if (first >= n)
+					break;
+
+				std::size_t last = first + D < n ? first + D : n, min = first;
+
+				for (std::size_t c = first + 1; c < last; c++)
+					if (_heap[c].first < _heap[min].first)
+						min = c;
+
+				if (!(_heap[min].first < entry.first))
+					break;
+
+				_heap[i] = _heap[min];
+				_position[_heap[i].second] = i;
+				i = min;
+			}
+
+			_heap[i] = entry;
+			_position[entry.second] = i;
+		}
+
+		std::vector<std::pair<Key, std::size_t>> _heap;
+		std::vector<std::size_t> _position;
+	};
+
+	template<class Key, unsigned D>
+	const std::size_t indexed_heap<Key, D>::npos;
+}
+
+#endif
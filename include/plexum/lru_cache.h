@@ -0,0 +1,152 @@
+/*
+ * plexum graph library
+ *
+ * oliver dot michel at colorado dot edu
+ *
+ * MIT License
+ */
+
+#ifndef PLEXUM_LRU_CACHE_H
+#define PLEXUM_LRU_CACHE_H
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+namespace plexum
+{
+	//
+	// plexum::lru_cache<Key, Value, Hash>
+	//
+
+	/*! @brief A map holding at most a fixed number of entries, evicting the least recently used
+	 *         one when it is full.
+	 *  @details Lookups and insertions take expected O(1). A capacity of 0 disables the cache.
+	 */
+	template<class Key, class Value, class Hash = std::hash<Key>>
+	class lru_cache
+	{
+	public:
+
+		explicit lru_cache(std::size_t capacity = 0)
+			: _capacity(capacity),
+			  _entries(),
+			  _index()
+		{ }
+
+		// the index refers into the entry list, so copies rebuild it
+		lru_cache(const lru_cache& other)
+			: _capacity(other._capacity),
+			  _entries(other._entries),
+			  _index()
+		{
+			for (auto i = _entries.begin(); i != _entries.end(); ++i)
+				_index.emplace(i->first, i);
+		}
+
+		lru_cache& operator=(lru_cache other)
+		{
+			std::swap(_capacity, other._capacity);
+			_entries.swap(other._entries);
+			_index.swap(other._index);
+			return *this;
+		}
+
+		/*! @brief returns the value stored for *key* and marks it most recently used, or
+		 *         nullptr if there is none
+		 *  @details the pointer is valid until the entry is erased or evicted
+		 */
+		Value* find(const Key& key)
+		{
+			auto i = _index.find(key);
+
+			if (i == _index.end())
+				return nullptr;
+
+			_entries.splice(_entries.begin(), _entries, i->second);
+			return &(i->second->second);
+		}
+
+		/*! @brief stores *value* for *key* as the most recently used entry, evicting the least
+		 *         recently used entry if the cache is full
+		 *  @return true if an entry was evicted
+		 */
+		bool insert(const Key& key, Value value)
+		{
+			if (_capacity == 0)
+				return false;
+
+			auto i = _index.find(key);
+
+			if (i != _index.end()) {
+				i->second->second = std::move(value);
+				_entries.splice(_entries.begin(), _entries, i->second);
+				return false;
+			}
+
+			bool evicted = _entries.size() == _capacity;
+
+			if (evicted) {
+				_index.erase(_entries.back().first);
+				_entries.pop_back();
+			}
+
+			_entries.emplace_front(key, std::move(value));
+			_index.emplace(key, _entries.begin());
+			return evicted;
+		}
+
+		/*! @brief removes the entry for *key* if there is one */
+		void erase(const Key& key)
+		{
+			auto i = _index.find(key);
+
+			if (i != _index.end()) {
+				_entries.erase(i->second);
+				_index.erase(i);
+			}
+		}
+
+		/*! @brief removes all entries */
+		void clear()
+		{
+			_entries.clear();
+			_index.clear();
+		}
+
+		/*! @brief sets the number of entries the cache holds, evicting the least recently used
+		 *         ones beyond it
+		 */
+		void set_capacity(std::size_t capacity)
+		{
+			_capacity = capacity;
+
+			while (_entries.size() > _capacity) {
+				_index.erase(_entries.back().first);
+				_entries.pop_back();
+			}
+		}
+
+		inline std::size_t capacity() const
+		{
+			return _capacity;
+		}
+
+		inline std::size_t size() const
+		{
+			return _entries.size();
+		}
+
+	private:
+
+		typedef std::list<std::pair<Key, Value>> entry_list;
+
+		std::size_t _capacity;
+		entry_list _entries;
+		std::unordered_map<Key, typename entry_list::iterator, Hash> _index;
+	};
+}
+
+#endif
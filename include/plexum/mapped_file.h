@@ -0,0 +1,104 @@
+/*
+ * plexum graph library
+ *
+ * oliver dot michel at colorado dot edu
+ *
+ * MIT License
+ */
+
+#ifndef PLEXUM_MAPPED_FILE_H
+#define PLEXUM_MAPPED_FILE_H
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <plexum/exception.h>
+
+namespace plexum
+{
+	//
+	// plexum::mapped_file
+	//
+
+	/*! @brief A file mapped read-only into memory.
+	 *  @details The contents are paged in by the operating system on first access, so mapping
+	 *           a file takes constant time regardless of its size, and processes mapping the same
+	 *           file share its pages. The mapping stays valid until the object is destroyed.
+	 */
+	class mapped_file
+	{
+	public:
+
+		/*! @brief maps the file at *path*
+		 *  @throws exception if the file cannot be opened or mapped
+		 */
+		explicit mapped_file(const std::string& path)
+			: _data(nullptr),
+			  _size(0)
+		{
+			int fd = ::open(path.c_str(), O_RDONLY);
+
+			if (fd < 0)
+				throw exception("mapped_file: cannot open " + path + ": " + std::strerror(errno));
+
+			struct stat st;
+
+			if (::fstat(fd, &st) != 0) {
+				int error = errno;
+				::close(fd);
+				throw exception("mapped_file: cannot stat " + path + ": " + std::strerror(error));
+			}
+
+			_size = static_cast<std::size_t>(st.st_size);
+
+			// empty files cannot be mapped, they are represented without a mapping
+			if (_size > 0) {
+				void* p = ::mmap(nullptr, _size, PROT_READ, MAP_SHARED, fd, 0);
+
+				if (p == MAP_FAILED) {
+					int error = errno;
+					::close(fd);
+					throw exception("mapped_file: cannot map " + path + ": " + std::strerror(error));
+				}
+
+				_data = static_cast<const char*>(p);
+			}
+
+			::close(fd);
+		}
+
+		mapped_file(const mapped_file&) = delete;
+		mapped_file& operator=(const mapped_file&) = delete;
+
+		~mapped_file()
+		{
+			if (_data != nullptr)
+				::munmap(const_cast<char*>(_data), _size);
+		}
+
+		/*! @brief returns the first byte of the mapping, which is aligned to a page boundary */
+		inline const char* data() const
+		{
+			return _data;
+		}
+
+		/*! @brief returns the size of the file in bytes */
+		inline std::size_t size() const
+		{
+			return _size;
+		}
+
+	private:
+		const char* _data;
+		std::size_t _size;
+	};
+}
+
+#endif
@@ -0,0 +1,290 @@
+/*
+ * plexum graph library
+ *
+ * oliver dot michel at colorado dot edu
+ *
+ * MIT License
+ */
+
+#ifndef PLEXUM_MEMORY_H
+#define PLEXUM_MEMORY_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace plexum
+{
+	//
+	// plexum::memory_resource
+	//
+
+	/*! @brief An abstract source of memory for graph storage, modeled after
+	 *         std::pmr::memory_resource.
+	 *  @details A Graph constructed with a memory resource allocates all of its vertex and edge
+	 *           storage and adjacency lists from it. The resource must outlive the graph.
+	 */
+	class memory_resource
+	{
+	public:
+
+		virtual ~memory_resource()
+		{ }
+
+		/*! @brief returns *bytes* bytes of memory aligned to *alignment* */
+		inline void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t))
+		{
+			return do_allocate(bytes, alignment);
+		}
+
+		/*! @brief returns memory obtained from allocate() with the same size and alignment */
+		inline void deallocate(void* p, std::size_t bytes,
+							   std::size_t alignment = alignof(std::max_align_t))
+		{
+			do_deallocate(p, bytes, alignment);
+		}
+
+		/*! @brief checks whether memory allocated from *other* can be deallocated by this resource */
+		inline bool is_equal(const memory_resource& other) const
+		{
+			return this == &other;
+		}
+
+	protected:
+
+		virtual void* do_allocate(std::size_t bytes, std::size_t alignment) = 0;
+
+		virtual void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) = 0;
+	};
+
+	//
+	// plexum::new_delete_resource()
+	//
+
+	//! @cond
+
+	class _new_delete_resource : public memory_resource
+	{
+	protected:
+
+		void* do_allocate(std::size_t bytes, std::size_t)
+		{
+			return ::operator new(bytes);
+		}
+
+		void do_deallocate(void* p, std::size_t, std::size_t)
+		{
+			::operator delete(p);
+		}
+	};
+
+	//! @endcond
+
+	/*! @brief returns the process-wide resource using global operator new and delete, the
+	 *         default of all graphs
+	 */
+	inline memory_resource* new_delete_resource()
+	{
+		static _new_delete_resource r;
+		return &r;
+	}
+
+	//
+	// plexum::monotonic_arena
+	//
+
+	/*! @brief A memory resource handing out memory from a list of growing blocks.
+	 *  @details Allocation bumps a pointer, and deallocation does nothing, so the nodes of a
+	 *           graph built on an arena sit next to each other in the order they were created.
+	 *           Memory is reclaimed all at once: reset() rewinds the arena to reuse its blocks,
+	 *           and release() returns them upstream. Memory freed by the graph, such as the old
+	 *           buffer of a grown adjacency list, is not reused before that. An arena is not
+	 *           thread-safe.
+	 */
+	class monotonic_arena : public memory_resource
+	{
+	public:
+
+		/*! @brief the size of the first block if none is given */
+		static const std::size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+		/*! @brief constructs an arena whose first block holds *initial_size* bytes, allocating
+		 *         its blocks from *upstream*
+		 */
+		explicit monotonic_arena(std::size_t initial_size = DEFAULT_BLOCK_SIZE,
+								 memory_resource* upstream = new_delete_resource())
+			: _upstream(upstream),
+			  _head(nullptr),
+			  _current(nullptr),
+			  _next_size(std::max<std::size_t>(initial_size, 2 * sizeof(_block))),
+			  _allocated(0)
+		{ }
+
+		monotonic_arena(const monotonic_arena&) = delete;
+		monotonic_arena& operator=(const monotonic_arena&) = delete;
+
+		~monotonic_arena()
+		{
+			release();
+		}
+
+		/*! @brief makes all memory available again, keeping the blocks for reuse
+		 *  @details everything allocated from the arena must be destroyed before
+		 */
+		void reset()
+		{
+			for (_block* b = _head; b != nullptr; b = b->next)
+				b->used = sizeof(_block);
+
+			_current = _head;
+			_allocated = 0;
+		}
+
+		/*! @brief returns all blocks to the upstream resource
+		 *  @details everything allocated from the arena must be destroyed before
+		 */
+		void release()
+		{
+			while (_head != nullptr) {
+				_block* b = _head;
+				_head = b->next;
+				_upstream->deallocate(b, b->size, alignof(_block));
+			}
+
+			_current = nullptr;
+			_allocated = 0;
+		}
+
+		/*! @brief returns the number of bytes handed out since the last reset() or release() */
+		inline std::size_t allocated() const
+		{
+			return _allocated;
+		}
+
+	protected:
+
+		void* do_allocate(std::size_t bytes, std::size_t alignment)
+		{
+			for (;;) {
+				if (_current != nullptr) {
+					std::uintptr_t base = reinterpret_cast<std::uintptr_t>(_current);
+					std::uintptr_t p = (base + _current->used + alignment - 1) & ~(alignment - 1);
+
+					if (p + bytes <= base + _current->size) {
+						_current->used = p + bytes - base;
+						_allocated += bytes;
+						return reinterpret_cast<void*>(p);
+					}
+
+					// blocks kept by reset() are reused before new ones are allocated
+					if (_current->next != nullptr) {
+						_current = _current->next;
+						continue;
+					}
+				}
+
+				_grow(bytes + alignment);
+			}
+		}
+
+		void do_deallocate(void*, std::size_t, std::size_t)
+		{ }
+
+	private:
+
+		// the header at the start of every block
+		struct _block
+		{
+			_block* next;
+			std::size_t size;
+			std::size_t used;
+		};
+
+		// appends a block with room for at least *bytes* bytes, doubling the block size
+		void _grow(std::size_t bytes)
+		{
+			std::size_t size = std::max(_next_size, bytes + sizeof(_block));
+			_block* b = static_cast<_block*>(_upstream->allocate(size, alignof(_block)));
+
+			b->next = nullptr;
+			b->size = size;
+			b->used = sizeof(_block);
+
+			if (_current != nullptr)
+				_current->next = b;
+			else
+				_head = b;
+
+			_current = b;
+			_next_size = 2 * size;
+		}
+
+		memory_resource* _upstream;
+		_block* _head;
+		_block* _current;
+		std::size_t _next_size;
+		std::size_t _allocated;
+	};
+
+	//
+	// plexum::resource_allocator<T>
+	//
+
+	/*! @brief A standard allocator drawing memory from a memory_resource.
+	 *  @details Containers using it keep the resource they were constructed with for their
+	 *           lifetime, and copies of them allocate from the same resource.
+	 */
+	template<class T>
+	class resource_allocator
+	{
+		template<class U>
+		friend class resource_allocator;
+
+	public:
+
+		typedef T value_type;
+
+		resource_allocator(memory_resource* r = new_delete_resource())
+			: _r(r)
+		{ }
+
+		template<class U>
+		resource_allocator(const resource_allocator<U>& other)
+			: _r(other._r)
+		{ }
+
+		T* allocate(std::size_t n)
+		{
+			return static_cast<T*>(_r->allocate(n * sizeof(T), alignof(T)));
+		}
+
+		void deallocate(T* p, std::size_t n)
+		{
+			_r->deallocate(p, n * sizeof(T), alignof(T));
+		}
+
+		/*! @brief returns the resource the allocator draws from */
+		inline memory_resource* resource() const
+		{
+			return _r;
+		}
+
+		template<class U>
+		inline bool operator==(const resource_allocator<U>& other) const
+		{
+			return _r->is_equal(*other._r);
+		}
+
+		template<class U>
+		inline bool operator!=(const resource_allocator<U>& other) const
+		{
+			return !(*this == other);
+		}
+
+	private:
+		memory_resource* _r;
+	};
+}
+
+#endif
@@ -0,0 +1,246 @@
+/*
+ * plexum graph library
+ *
+ * oliver dot michel at colorado dot edu
+ *
+ * MIT License
+ */
+
+#ifndef PLEXUM_OUTPUT_H
+#define PLEXUM_OUTPUT_H
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace plexum
+{
+	//
+	// plexum::output_buffer
+	//
+
+	/*! @brief A buffer collecting formatted text before writing it to a stream in large blocks.
+	 *  @details Integers and floating point numbers are formatted without going through the
+	 *           stream, character and other types through their operator<<. Nothing reaches the stream before
+	 *           flush() or commit() is called, so a value can be escaped after it was formatted.
+	 *           The destructor flushes the remaining text.
+	 */
+	class output_buffer
+	{
+	public:
+
+		/*! @brief the number of bytes collected before commit() writes them to the stream */
+		static const std::size_t DEFAULT_CAPACITY = 1 << 20;
+
+		/*! @brief the escaping applied by escape() */
+		enum escaping
+		{
+			dot_string,	//!< backslashes, quotes and newlines inside a quoted DOT string
+			xml_text	//!< markup characters in XML character data and attribute values
+		};
+
+		explicit output_buffer(std::ostream& os, std::size_t capacity = DEFAULT_CAPACITY)
+			: _os(os),
+			  _capacity(capacity),
+			  _buffer(),
+			  _scratch()
+		{
+			_buffer.reserve(capacity);
+		}
+
+		output_buffer(const output_buffer&) = delete;
+		output_buffer& operator=(const output_buffer&) = delete;
+
+		~output_buffer()
+		{
+			flush();
+		}
+
+		/*! @brief appends *n* bytes at *s* */
+		inline output_buffer& write(const char* s, std::size_t n)
+		{
+			_buffer.insert(_buffer.end(), s, s + n);
+			return *this;
+		}
+
+		inline output_buffer& operator<<(char c)
+		{
+			_buffer.push_back(c);
+			return *this;
+		}
+
+		inline output_buffer& operator<<(const char* s)
+		{
+			return write(s, std::strlen(s));
+		}
+
+		inline output_buffer& operator<<(const std::string& s)
+		{
+			return write(s.data(), s.size());
+		}
+
+		/*! @brief appends *value*, formatting numbers directly and character and other types
+		 *         through a std::ostringstream
+		 */
+		template<class T>
+		inline output_buffer& operator<<(const T& value)
+		{
+			_put(value, std::integral_constant<int, _is_character<T>::value ? 0
+				: std::is_integral<T>::value ? 1 : std::is_floating_point<T>::value ? 2 : 0>());
+			return *this;
+		}
+
+		/*! @brief returns the number of bytes not yet written to the stream */
+		inline std::size_t size() const
+		{
+			return _buffer.size();
+		}
+
+		/*! @brief escapes the text appended since size() returned *from* */
+		void escape(std::size_t from, escaping e)
+		{
+			std::size_t i = from;
+
+			while (i < _buffer.size() && !_escaped(_buffer[i], e))
+				i++;
+
+			if (i == _buffer.size())
+				return;
+
+			std::string escaped(_buffer.begin() + static_cast<std::ptrdiff_t>(i), _buffer.end());
+			_buffer.resize(i);
+
+			for (char c : escaped) {
+				if (!_escaped(c, e)) {
+					_buffer.push_back(c);
+				} else if (e == dot_string) {
+					_buffer.push_back('\\');
+					_buffer.push_back(c == '\n' ? 'n' : c);
+				} else if (c == '&') {
+					*this << "&amp;";
+				} else if (c == '<') {
+					*this << "&lt;";
+				} else if (c == '>') {
+					*this << "&gt;";
+				} else {
+					*this << "&quot;";
+				}
+			}
+		}
+
+		/*! @brief discards the text appended since size() returned *from* */
+		inline void truncate(std::size_t from)
+		{
+			_buffer.resize(from);
+		}
+
+		/*! @brief writes the buffer to the stream if it holds at least its capacity */
+		inline void commit()
+		{
+			if (_buffer.size() >= _capacity)
+				flush();
+		}
+
+		/*! @brief writes the buffer to the stream */
+		void flush()
+		{
+			if (!_buffer.empty())
+				_os.write(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+
+			_buffer.clear();
+		}
+
+	private:
+
+		// the character types, left to the stream whose formatting of them differs from numbers
+		template<class T>
+		struct _is_character
+			: std::integral_constant<bool, std::is_same<T, signed char>::value
+				|| std::is_same<T, unsigned char>::value || std::is_same<T, wchar_t>::value
+				|| std::is_same<T, char16_t>::value || std::is_same<T, char32_t>::value>
+		{ };
+
+		static inline bool _escaped(char c, escaping e)
+		{
+			return e == dot_string ? c == '"' || c == '\\' || c == '\n'
+				: c == '&' || c == '<' || c == '>' || c == '"';
+		}
+
+		template<class T>
+		void _put(const T& value, std::integral_constant<int, 1>)
+		{
+			typedef typename std::make_unsigned<T>::type U;
+
+			char digits[24];
+			char* p = digits + sizeof(digits);
+			bool negative = value < 0;
+			U u = negative ? U(0) - static_cast<U>(value) : static_cast<U>(value);
+
+			do {
+				*--p = static_cast<char>('0' + u % 10);
+				u /= 10;
+			} while (u != 0);
+
+			if (negative)
+				*--p = '-';
+
+			write(p, static_cast<std::size_t>(digits + sizeof(digits) - p));
+		}
+
+		void _put(bool value, std::integral_constant<int, 1>)
+		{
+			_buffer.push_back(value ? '1' : '0');
+		}
+
+		// the shortest of 15 and 17 significant digits that reads back as *value*
+		template<class T>
+		void _put(const T& value, std::integral_constant<int, 2>)
+		{
+			char s[32];
+			int n = std::snprintf(s, sizeof(s), "%.15g", static_cast<double>(value));
+
+			if (std::strtod(s, nullptr) != static_cast<double>(value))
+				n = std::snprintf(s, sizeof(s), "%.17g", static_cast<double>(value));
+
+			write(s, static_cast<std::size_t>(n));
+		}
+
+		template<class T>
+		void _put(const T& value, std::integral_constant<int, 0>)
+		{
+			_scratch.str(std::string());
+			_scratch << value;
+			*this << _scratch.str();
+		}
+
+		std::ostream& _os;
+		std::size_t _capacity;
+		std::vector<char> _buffer;
+		std::ostringstream _scratch;
+	};
+
+	//
+	// plexum::default_format
+	//
+
+	/*! @brief the formatter used by the Graph exporters unless another one is given
+	 *  @details a formatter is called with the output_buffer and the vertex or edge value and
+	 *           appends the text representing the value
+	 */
+	struct default_format
+	{
+		template<class T>
+		inline void operator()(output_buffer& out, const T& value) const
+		{
+			out << value;
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,142 @@
+/*
+ * plexum graph library
+ *
+ * oliver dot michel at colorado dot edu
+ *
+ * MIT License
+ */
+
+#ifndef PLEXUM_PARALLEL_H
+#define PLEXUM_PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace plexum
+{
+	/*! @brief returns the number of hardware threads, at least 1 */
+	inline unsigned hardware_threads()
+	{
+		return std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	/*! @brief splits [first, last) into contiguous blocks and runs f(begin, end, thread) on each
+	 *  @details uses at most *threads* threads (0 selects hardware_threads()) and never hands a
+	 *           thread fewer than *grain* elements, so small ranges run on the calling thread. The
+	 *           calling thread processes the first block itself. If f throws, all threads are
+	 *           joined and the first exception is rethrown on the calling thread.
+	 */
+	template<typename F>
+	void parallel_for(std::size_t first, std::size_t last, unsigned threads, std::size_t grain, F f)
+	{
+		std::size_t n = last > first ? last - first : 0;
+
+		if (threads == 0)
+			threads = hardware_threads();
+
+		threads = static_cast<unsigned>(
+			std::max<std::size_t>(1, std::min<std::size_t>(threads, n / std::max<std::size_t>(1, grain))));
+
+		if (threads == 1) {
+			f(first, last, 0u);
+			return;
+		}
+
+		std::exception_ptr error;
+		std::mutex error_mutex;
+
+		auto work = [&](std::size_t begin, std::size_t end, unsigned t) {
+			try {
+				f(begin, end, t);
+			} catch (...) {
+				std::lock_guard<std::mutex> lock(error_mutex);
+				if (!error)
+					error = std::current_exception();
+			}
+		};
+
+		std::vector<std::thread> workers;
+
+		try {
+			workers.reserve(threads - 1);
+
+			for (unsigned t = 1; t < threads; t++)
+				workers.emplace_back(work, first + n * t / threads, first + n * (t + 1) / threads, t);
+		} catch (...) {
+			for (std::thread& w : workers)
+				w.join();
+			throw;
+		}
+
+		work(first, first + n / threads, 0u);
+
+		for (std::thread& w : workers)
+			w.join();
+
+		if (error)
+			std::rethrow_exception(error);
+	}
+
+	/*! @brief runs f(i, thread) for every i in [first, last), handing out one index at a time
+	 *  @details suited for iterations of uneven cost. Uses at most *threads* threads (0 selects
+	 *           hardware_threads()), including the calling thread. If f throws, the remaining
+	 *           indices are skipped and the first exception is rethrown on the calling thread.
+	 */
+	template<typename F>
+	void parallel_for_each(std::size_t first, std::size_t last, unsigned threads, F f)
+	{
+		std::size_t n = last > first ? last - first : 0;
+
+		if (threads == 0)
+			threads = hardware_threads();
+
+		threads = static_cast<unsigned>(std::max<std::size_t>(1, std::min<std::size_t>(threads, n)));
+
+		std::atomic<std::size_t> next(first);
+		std::atomic<bool> failed(false);
+		std::exception_ptr error;
+		std::mutex error_mutex;
+
+		auto work = [&](unsigned t) {
+			try {
+				for (std::size_t i = next++; i < last && !failed; i = next++)
+					f(i, t);
+			} catch (...) {
+				std::lock_guard<std::mutex> lock(error_mutex);
+				if (!failed.exchange(true))
+					error = std::current_exception();
+			}
+		};
+
+		std::vector<std::thread> workers;
+
+		try {
+			workers.reserve(threads - 1);
+
+			for (unsigned t = 1; t < threads; t++)
+				workers.emplace_back(work, t);
+		} catch (...) {
+			// the started workers stop after their current index
+			failed = true;
+
+			for (std::thread& w : workers)
+				w.join();
+			throw;
+		}
+
+		work(0u);
+
+		for (std::thread& w : workers)
+			w.join();
+
+		if (error)
+			std::rethrow_exception(error);
+	}
+}
+
+#endif
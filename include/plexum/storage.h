@@ -0,0 +1,478 @@
+/*
+ * plexum graph library
+ *
+ * oliver dot michel at colorado dot edu
+ *
+ * MIT License
+ */
+
+#ifndef PLEXUM_STORAGE_H
+#define PLEXUM_STORAGE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <plexum/memory.h>
+#include <plexum/parallel.h>
+
+namespace plexum
+{
+	//
+	// plexum::map_storage<T>
+	//
+
+	/*! @brief Ordered element storage backed by a std::map.
+	 *  @details Ids are handed out sequentially and never reused. Lookups take O(log n) and
+	 *           iteration visits elements in id order. This is the default Graph storage.
+	 *  @tparam T the stored element type, constructible from (id, args...)
+	 */
+	template<class T>
+	class map_storage
+	{
+	public:
+
+		typedef std::pair<const std::size_t, T> value_type;
+		typedef std::map<std::size_t, T, std::less<std::size_t>, resource_allocator<value_type>> map_type;
+		typedef typename map_type::iterator iterator;
+
+		/*! @brief constructs an empty storage allocating its nodes from *r* */
+		explicit map_storage(memory_resource* r = new_delete_resource())
+			: _next(0),
+			  _elements(std::less<std::size_t>(), resource_allocator<value_type>(r))
+		{ }
+
+		/*! @brief constructs a new element with the next free id
+		 *  @return an iterator to the new element
+		 */
+		template<class... Args>
+		iterator emplace(Args&&... args)
+		{
+			std::size_t id = _next++;
+
+			return _elements.emplace_hint(
+				_elements.end(),
+				std::piecewise_construct,
+				std::forward_as_tuple(id),
+				std::forward_as_tuple(id, std::forward<Args>(args)...)
+			);
+		}
+
+		/*! @brief constructs *n* elements, the i-th from (value(i), args...), and calls
+		 *         visit(i, element) for each
+		 *  @details runs on the calling thread in input order, *threads* is ignored. If a
+		 *           construction or *visit* throws, the elements constructed so far are removed.
+		 */
+		template<class V, class F, class... Args>
+		void emplace_range(std::size_t n, unsigned, V value, F visit, Args&&... args)
+		{
+			std::size_t first = _next;
+
+			try {
+				for (std::size_t i = 0; i < n; i++)
+					visit(i, *emplace(value(i), args...));
+			} catch (...) {
+				_elements.erase(_elements.lower_bound(first), _elements.end());
+				throw;
+			}
+		}
+
+		/*! @brief removes the element at *pos*
+		 *  @return an iterator to the element following *pos*
+		 */
+		iterator erase(iterator pos)
+		{
+			return _elements.erase(pos);
+		}
+
+		/*! @brief prepares for *n* more insertions, a no-op as map nodes are allocated singly */
+		void reserve(std::size_t)
+		{ }
+
+		/*! @brief returns an iterator to the element with *id* or end() if there is none */
+		iterator find(std::size_t id)
+		{
+			return _elements.find(id);
+		}
+
+		inline iterator begin()
+		{
+			return _elements.begin();
+		}
+
+		inline iterator end()
+		{
+			return _elements.end();
+		}
+
+		inline std::size_t size() const
+		{
+			return _elements.size();
+		}
+
+		/*! @brief returns an exclusive upper bound on the dense indices of all stored elements */
+		inline std::size_t bound() const
+		{
+			return _next;
+		}
+
+		/*! @brief returns the dense index of the element with *id* */
+		static inline std::size_t index(std::size_t id)
+		{
+			return id;
+		}
+
+	private:
+		std::size_t _next;
+		map_type _elements;
+	};
+
+	//
+	// plexum::slot_storage<T>
+	//
+
+	/*! @brief Dense element storage with O(1) lookups and slot recycling.
+	 *  @details Elements live in fixed-size chunks of contiguous slots, so their addresses remain
+	 *           stable while the storage grows. Erased slots are recycled by later insertions. An
+	 *           id packs the slot index into its lower 32 bits and a per-slot generation counter
+	 *           into its upper 32 bits, so ids of erased elements are never resolved to an element
+	 *           that later took over the slot. Iteration visits occupied slots in slot order.
+	 *  @tparam T the stored element type, constructible from (id, args...)
+	 */
+	template<class T>
+	class slot_storage
+	{
+		static_assert(sizeof(std::size_t) >= 8, "slot_storage requires 64-bit ids");
+
+	public:
+
+		typedef std::pair<const std::size_t, T> value_type;
+
+		/*! @brief the number of slots allocated at once */
+		static const std::size_t CHUNK_SIZE = 1024;
+
+		/*! @brief the number of id bits holding the slot index */
+		static const std::size_t INDEX_BITS = 32;
+
+		/*! @brief the least number of elements emplace_range() constructs per thread */
+		static const std::size_t PARALLEL_GRAIN = 1 << 16;
+
+	private:
+
+		struct slot
+		{
+			typename std::aligned_storage<sizeof(value_type), alignof(value_type)>::type data;
+			std::uint32_t generation;
+			bool occupied;
+
+			inline value_type* ptr()
+			{
+				return reinterpret_cast<value_type*>(&data);
+			}
+		};
+
+	public:
+
+		//
+		// plexum::slot_storage<T>::iterator
+		//
+
+		class iterator : public std::iterator<std::forward_iterator_tag, value_type>
+		{
+			friend class slot_storage<T>;
+
+		public:
+
+			iterator()
+				: _s(nullptr),
+				  _n(0)
+			{ }
+
+			inline iterator& operator++()
+			{
+				_n = _s->_next_occupied(_n + 1);
+				return *this;
+			}
+
+			inline iterator operator++(int)
+			{
+				iterator i = *this;
+				++(*this);
+				return i;
+			}
+
+			inline value_type& operator*() const
+			{
+				return *(_s->_slot(_n).ptr());
+			}
+
+			inline value_type* operator->() const
+			{
+				return _s->_slot(_n).ptr();
+			}
+
+			inline bool operator==(const iterator& other) const
+			{
+				return _n == other._n;
+			}
+
+			inline bool operator!=(const iterator& other) const
+			{
+				return _n != other._n;
+			}
+
+		private:
+
+			iterator(slot_storage<T>* s, std::size_t n)
+				: _s(s),
+				  _n(n)
+			{ }
+
+			slot_storage<T>* _s;
+			std::size_t _n;
+		};
+
+		/*! @brief constructs an empty storage allocating its chunks from *r* */
+		explicit slot_storage(memory_resource* r = new_delete_resource())
+			: _resource(r),
+			  _chunks(resource_allocator<slot*>(r)),
+			  _free(resource_allocator<std::size_t>(r)),
+			  _bound(0),
+			  _size(0)
+		{ }
+
+		slot_storage(const slot_storage&) = delete;
+		slot_storage& operator=(const slot_storage&) = delete;
+
+		~slot_storage()
+		{
+			for (std::size_t n = 0; n < _bound; n++)
+				if (_slot(n).occupied)
+					_slot(n).ptr()->~value_type();
+
+			for (slot* c : _chunks)
+				_resource->deallocate(c, CHUNK_SIZE * sizeof(slot), alignof(slot));
+		}
+
+		/*! @brief constructs a new element, reusing a free slot if there is one
+		 *  @return an iterator to the new element
+		 */
+		template<class... Args>
+		iterator emplace(Args&&... args)
+		{
+			std::size_t n;
+
+			if (!_free.empty()) {
+				n = _free.back();
+				_free.pop_back();
+			} else {
+				if (_bound == _chunks.size() * CHUNK_SIZE)
+					_add_chunk();
+				n = _bound++;
+			}
+
+			slot& s = _slot(n);
+			std::size_t id = (static_cast<std::size_t>(s.generation) << INDEX_BITS) | n;
+
+			new (&s.data) value_type(
+				std::piecewise_construct,
+				std::forward_as_tuple(id),
+				std::forward_as_tuple(id, std::forward<Args>(args)...)
+			);
+
+			s.occupied = true;
+			_size++;
+			return iterator(this, n);
+		}
+
+		/*! @brief constructs *n* elements, the i-th from (value(i), args...), and calls
+		 *         visit(i, element) for each
+		 *  @details claims free slots first and fresh slots after them, then constructs the
+		 *           elements on up to *threads* threads (0 selects one per hardware thread) for
+		 *           large ranges. *value* and *visit* run on the thread constructing the element
+		 *           and must be safe to call concurrently for different i; on a single thread
+		 *           they are called in input order. If a construction or *visit* throws, the
+		 *           constructed elements are destroyed and the exception is rethrown.
+		 */
+		template<class V, class F, class... Args>
+		void emplace_range(std::size_t n, unsigned threads, V value, F visit, Args&&... args)
+		{
+			std::size_t reused = std::min(n, _free.size());
+			std::size_t first = _bound;
+			std::size_t initialized = _chunks.size() * CHUNK_SIZE;
+
+			// new chunks are initialized on the threads constructing their elements, so their
+			// pages are first touched in parallel
+			try {
+				while (_chunks.size() * CHUNK_SIZE < first + n - reused)
+					_chunks.push_back(_allocate_chunk());
+			} catch (...) {
+				_initialize(initialized, _chunks.size() * CHUNK_SIZE);
+				throw;
+			}
+
+			parallel_for(initialized, _chunks.size() * CHUNK_SIZE, threads, PARALLEL_GRAIN,
+				[this](std::size_t b, std::size_t e, unsigned) {
+					_initialize(b, e);
+				});
+
+			_bound += n - reused;
+
+			// the i-th element takes the i-th free slot from the back, then the fresh slots
+			auto slot_of = [&](std::size_t i) {
+				return i < reused ? _free[_free.size() - 1 - i] : first + (i - reused);
+			};
+
+			try {
+				parallel_for(0, n, threads, PARALLEL_GRAIN, [&](std::size_t b, std::size_t e, unsigned) {
+					for (std::size_t i = b; i < e; i++) {
+						std::size_t k = slot_of(i);
+						slot& s = _slot(k);
+						std::size_t id = (static_cast<std::size_t>(s.generation) << INDEX_BITS) | k;
+
+						new (&s.data) value_type(
+							std::piecewise_construct,
+							std::forward_as_tuple(id),
+							std::forward_as_tuple(id, value(i), args...)
+						);
+
+						s.occupied = true;
+						visit(i, *s.ptr());
+					}
+				});
+			} catch (...) {
+				for (std::size_t i = 0; i < n; i++) {
+					slot& s = _slot(slot_of(i));
+
+					if (s.occupied) {
+						s.ptr()->~value_type();
+						s.occupied = false;
+						s.generation++;
+					}
+				}
+
+				_bound = first;
+				throw;
+			}
+
+			_free.resize(_free.size() - reused);
+			_size += n;
+		}
+
+		/*! @brief allocates the chunks needed for *n* more insertions up front */
+		void reserve(std::size_t n)
+		{
+			std::size_t fresh = n > _free.size() ? n - _free.size() : 0;
+
+			while (_chunks.size() * CHUNK_SIZE < _bound + fresh)
+				_add_chunk();
+		}
+
+		/*! @brief removes the element at *pos* and releases its slot for reuse
+		 *  @return an iterator to the element following *pos*
+		 */
+		iterator erase(iterator pos)
+		{
+			slot& s = _slot(pos._n);
+			s.ptr()->~value_type();
+			s.occupied = false;
+			s.generation++;
+			_free.push_back(pos._n);
+			_size--;
+			return iterator(this, _next_occupied(pos._n + 1));
+		}
+
+		/*! @brief returns an iterator to the element with *id* or end() if there is none */
+		iterator find(std::size_t id)
+		{
+			std::size_t n = index(id);
+
+			if (n < _bound) {
+				slot& s = _slot(n);
+				if (s.occupied && s.generation == (id >> INDEX_BITS))
+					return iterator(this, n);
+			}
+
+			return end();
+		}
+
+		inline iterator begin()
+		{
+			return iterator(this, _next_occupied(0));
+		}
+
+		inline iterator end()
+		{
+			return iterator(this, _bound);
+		}
+
+		inline std::size_t size() const
+		{
+			return _size;
+		}
+
+		/*! @brief returns an exclusive upper bound on the dense indices of all stored elements */
+		inline std::size_t bound() const
+		{
+			return _bound;
+		}
+
+		/*! @brief returns the dense index of the element with *id*, i.e. its slot index */
+		static inline std::size_t index(std::size_t id)
+		{
+			return id & ((static_cast<std::size_t>(1) << INDEX_BITS) - 1);
+		}
+
+	private:
+
+		void _add_chunk()
+		{
+			_chunks.push_back(_allocate_chunk());
+			_initialize((_chunks.size() - 1) * CHUNK_SIZE, _chunks.size() * CHUNK_SIZE);
+		}
+
+		inline slot* _allocate_chunk()
+		{
+			return static_cast<slot*>(_resource->allocate(CHUNK_SIZE * sizeof(slot), alignof(slot)));
+		}
+
+		// marks the slots [first, last) free, leaving their element storage uninitialized
+		void _initialize(std::size_t first, std::size_t last)
+		{
+			for (std::size_t n = first; n < last; n++) {
+				slot* s = new (&_slot(n)) slot;
+				s->generation = 0;
+				s->occupied = false;
+			}
+		}
+
+		inline slot& _slot(std::size_t n)
+		{
+			return _chunks[n / CHUNK_SIZE][n % CHUNK_SIZE];
+		}
+
+		std::size_t _next_occupied(std::size_t n)
+		{
+			while (n < _bound && !_slot(n).occupied)
+				n++;
+
+			return n;
+		}
+
+		memory_resource* _resource;
+		std::vector<slot*, resource_allocator<slot*>> _chunks;
+		std::vector<std::size_t, resource_allocator<std::size_t>> _free;
+		std::size_t _bound;
+		std::size_t _size;
+	};
+}
+
+#endif
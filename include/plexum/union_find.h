@@ -0,0 +1,118 @@
+/*
+ * plexum graph library
+ *
+ * oliver dot michel at colorado dot edu
+ *
+ * MIT License
+ */
+
+#ifndef PLEXUM_UNION_FIND_H
+#define PLEXUM_UNION_FIND_H
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace plexum
+{
+	//
+	// plexum::union_find
+	//
+
+	/*! @brief Disjoint sets over the indices 0, 1, 2, ... with union by size and path halving.
+	 *  @details Every index not touched yet forms a set of its own, so the structure grows
+	 *           with the largest index passed to unite(). find() takes amortized near-constant
+	 *           time, root() takes O(log n) without modifying the structure and can therefore
+	 *           be called concurrently.
+	 */
+	class union_find
+	{
+	public:
+
+		union_find()
+			: _parent(),
+			  _size()
+		{ }
+
+		/*! @brief makes every index a set of its own again */
+		void clear()
+		{
+			_parent.clear();
+			_size.clear();
+		}
+
+		/*! @brief returns the representative of the set holding *i*, shortening the path to it */
+		std::size_t find(std::size_t i)
+		{
+			if (i >= _parent.size())
+				return i;
+
+			while (_parent[i] != i) {
+				_parent[i] = _parent[_parent[i]];
+				i = _parent[i];
+			}
+
+			return i;
+		}
+
+		/*! @brief returns the representative of the set holding *i* */
+		std::size_t root(std::size_t i) const
+		{
+			if (i >= _parent.size())
+				return i;
+
+			while (_parent[i] != i)
+				i = _parent[i];
+
+			return i;
+		}
+
+		/*! @brief merges the sets holding *a* and *b*
+		 *  @return true if they were different sets
+		 */
+		bool unite(std::size_t a, std::size_t b)
+		{
+			_grow(std::max(a, b) + 1);
+
+			a = find(a);
+			b = find(b);
+
+			if (a == b)
+				return false;
+
+			if (_size[a] < _size[b])
+				std::swap(a, b);
+
+			_parent[b] = a;
+			_size[a] += _size[b];
+			return true;
+		}
+
+		/*! @brief returns the number of indices in the set holding *i* */
+		std::size_t set_size(std::size_t i) const
+		{
+			return i < _parent.size() ? _size[root(i)] : 1;
+		}
+
+	private:
+
+		void _grow(std::size_t n)
+		{
+			std::size_t old = _parent.size();
+
+			if (n <= old)
+				return;
+
+			_parent.resize(std::max(n, 2 * old));
+			_size.resize(_parent.size(), 1);
+			std::iota(_parent.begin() + old, _parent.end(), old);
+		}
+
+		std::vector<std::size_t> _parent;
+		std::vector<std::size_t> _size;
+	};
+}
+
+#endif
@@ -0,0 +1,122 @@
+#include <catch.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <plexum/concurrent_graph.h>
+
+typedef plexum::concurrent_graph<int, int, plexum::slot_storage> concurrent;
+
+TEST_CASE("concurrent graph", "[concurrent_graph]")
+{
+	concurrent c;
+	auto& g = c.writer();
+
+	SECTION("readers see published states only")
+	{
+		REQUIRE(c.snapshot()->vertex_count() == 0);
+
+		auto a = g.vertices.add(1);
+		auto b = g.vertices.add(2);
+		g.edges.add(a, b, 5);
+
+		REQUIRE(c.snapshot()->vertex_count() == 0);
+		REQUIRE(c.publish());
+		REQUIRE(c.published_version() == g.version());
+
+		auto s = c.snapshot();
+
+		REQUIRE(s->vertex_count() == 2);
+		REQUIRE(s->edge_count() == 1);
+
+		// held snapshots are unaffected by later updates
+		g.edges.remove(g.edges.begin());
+		g.vertices.add(3);
+
+		REQUIRE(c.publish());
+		REQUIRE(s->edge_count() == 1);
+		REQUIRE(s->edge(0) == 5);
+		REQUIRE(c.snapshot()->vertex_count() == 3);
+		REQUIRE(c.snapshot()->edge_count() == 0);
+	}
+
+	SECTION("unchanged graphs are not published again")
+	{
+		g.vertices.add(1);
+
+		REQUIRE(c.publish());
+
+		auto s = c.snapshot();
+
+		REQUIRE(!c.publish());
+		REQUIRE(c.snapshot() == s);
+
+		*g.vertices.begin() = 7;
+
+		REQUIRE(c.publish(1, true));
+		REQUIRE(c.snapshot()->vertex(0) == 7);
+	}
+
+	SECTION("readers search while the writer updates")
+	{
+		std::vector<plexum::Graph<int, int, plexum::slot_storage>::vertex_proxy::iterator> v;
+
+		for (int i = 0; i < 64; i++)
+			v.push_back(g.vertices.add(i));
+
+		// a ring, so every pair of vertices stays connected when a single edge is missing
+		for (int i = 0; i < 64; i++)
+			g.edges.add(v[i], v[(i + 1) % 64], i);
+
+		c.publish();
+
+		std::atomic<bool> done(false);
+		std::atomic<std::size_t> failures(0);
+		std::vector<std::thread> readers;
+
+		for (int r = 0; r < 3; r++) {
+			readers.emplace_back([&c, &done, &failures, r] {
+				concurrent::snapshot_type::search_workspace ws;
+				auto all = [](const int*) { return true; };
+
+				for (std::size_t i = 0; !done || i < 100; i++) {
+					auto s = c.snapshot();
+					std::size_t a = (i * 7 + r) % 64;
+					std::size_t b = (i * 13 + 5 * r) % 64;
+
+					try {
+						auto p = s->find_path(a, b, all, ws);
+						if (p.size() > 63 || (a != b && p.empty()))
+							failures++;
+					} catch (const plexum::exception&) {
+						failures++;
+					}
+
+					if (s->edge_count() < 63)
+						failures++;
+				}
+			});
+		}
+
+		for (int i = 0; i < 200; i++) {
+			auto e = g.edges.begin();
+			auto from = e.from();
+			auto to = e.to();
+			int value = *e;
+
+			g.edges.remove(e);
+			c.publish(1);
+			g.edges.add(from, to, value);
+			c.publish(1);
+		}
+
+		done = true;
+
+		for (auto& t : readers)
+			t.join();
+
+		REQUIRE(failures == 0);
+		REQUIRE(c.snapshot()->edge_count() == 64);
+	}
+}
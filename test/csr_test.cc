@@ -0,0 +1,404 @@
+#include <catch.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+#include <plexum/graph.h>
+
+TEST_CASE("csr snapshot", "[csr_graph]")
+{
+	plexum::Graph<int, int> g;
+
+	auto a = g.vertices.add(10);
+	auto b = g.vertices.add(20);
+	auto c = g.vertices.add(30);
+	auto d = g.vertices.add(40);
+	auto e = g.vertices.add(50);
+	auto e1 = g.edges.add(a, b, 1);
+	g.edges.add(b, c, 2);
+	auto e3 = g.edges.add(c, d, 3);
+	auto e4 = g.edges.add(a, c, 4);
+	std::size_t e_id = e.id();
+	std::size_t e1_id = e1.id();
+
+	g.edges.remove(e1);
+	g.vertices.remove(e);
+
+	SECTION("the snapshot holds all vertices and edges under dense indices")
+	{
+		auto s = g.freeze();
+
+		REQUIRE(s.vertex_count() == 4);
+		REQUIRE(s.edge_count() == 3);
+		REQUIRE(s.offsets().size() == 5);
+		REQUIRE(s.adjacency().size() == 6);
+
+		REQUIRE(s.vertex_id(s.vertex_index(c.id())) == c.id());
+		REQUIRE(s.vertex(s.vertex_index(c.id())) == 30);
+		REQUIRE(s.edge(s.edge_index(e3.id())) == 3);
+		REQUIRE(s.edge_id(s.edge_index(e4.id())) == e4.id());
+		REQUIRE_THROWS(s.vertex_index(e_id));
+		REQUIRE_THROWS(s.edge_index(e1_id));
+	}
+
+	SECTION("the snapshot preserves the adjacency of the graph")
+	{
+		auto s = g.freeze();
+		std::size_t ci = s.vertex_index(c.id());
+
+		REQUIRE(s.degree(ci) == 3);
+		REQUIRE(s.vertex(s.neighbors(ci)[0]) == 20);
+		REQUIRE(s.vertex(s.neighbors(ci)[1]) == 40);
+		REQUIRE(s.vertex(s.neighbors(ci)[2]) == 10);
+		REQUIRE(s.edge(s.edges(ci)[2]) == 4);
+		REQUIRE(s.source(s.edges(ci)[2]) == s.vertex_index(a.id()));
+		REQUIRE(s.target(s.edges(ci)[2]) == ci);
+		REQUIRE(s.degree(s.vertex_index(a.id())) == 1);
+	}
+
+	SECTION("the snapshot is printed like the graph")
+	{
+		std::stringstream gs, ss;
+		gs << g;
+		ss << g.freeze();
+
+		REQUIRE(gs.str() == ss.str());
+	}
+
+	SECTION("paths can be found on the snapshot")
+	{
+		auto s = g.freeze();
+		auto path = s.find_path(s.vertex_index(a.id()), s.vertex_index(d.id()));
+
+		REQUIRE(path.size() == 2);
+		REQUIRE(s.edge_id(path[0]) == e4.id());
+		REQUIRE(s.edge_id(path[1]) == e3.id());
+
+		path = s.find_path(s.vertex_index(b.id()), s.vertex_index(d.id()),
+						   [](const int* w) { return *w != 4; });
+
+		REQUIRE(path.size() == 2);
+		REQUIRE(s.edge(path[0]) == 2);
+		REQUIRE(s.edge(path[1]) == 3);
+		REQUIRE_THROWS(s.find_path(s.vertex_index(a.id()), s.vertex_index(d.id()),
+								   [](const int* w) { return *w != 4; }));
+		REQUIRE_THROWS_AS(s.find_path(s.vertex_count(), 0), plexum::exception);
+		REQUIRE_THROWS_AS(s.find_path(0, s.vertex_count() + 7), plexum::exception);
+	}
+
+	SECTION("the snapshot does not depend on the graph it was taken from")
+	{
+		auto s = g.freeze();
+		g.edges.remove(e3);
+
+		REQUIRE(s.edge_count() == 3);
+		REQUIRE(s.find_path(s.vertex_index(a.id()), s.vertex_index(d.id())).size() == 2);
+	}
+}
+
+TEST_CASE("parallel csr snapshot construction", "[csr_graph]")
+{
+	plexum::Graph<std::size_t, std::size_t, plexum::slot_storage> g;
+	std::vector<plexum::Graph<std::size_t, std::size_t, plexum::slot_storage>::vertex_proxy::iterator> v;
+
+	for (std::size_t i = 0; i < 2000; i++)
+		v.push_back(g.vertices.add(i));
+
+	for (std::size_t i = 0; i < 200000; i++)
+		g.edges.add(v[(i * 7919) % 2000], v[(i * 104729 + 1) % 2000], i);
+
+	auto s1 = g.freeze(1);
+	auto s4 = g.freeze(4);
+
+	REQUIRE(s1.offsets() == s4.offsets());
+	REQUIRE(s1.adjacency() == s4.adjacency());
+	REQUIRE(s1.adjacency_edges() == s4.adjacency_edges());
+
+	bool endpoints_match = true;
+
+	for (std::size_t e = 0; e < s4.edge_count(); e++)
+		endpoints_match &= s4.source(e) == s1.source(e) && s4.target(e) == s1.target(e);
+
+	REQUIRE(endpoints_match);
+}
+
+TEST_CASE("parallel_for rethrows worker exceptions", "[csr_graph]")
+{
+	std::atomic<std::size_t> visited(0);
+
+	REQUIRE_THROWS_AS(plexum::parallel_for(0, 1000, 4, 1, [&](std::size_t b, std::size_t e, unsigned t) {
+		visited += e - b;
+		if (t == 2)
+			throw std::runtime_error("worker failed");
+	}), std::runtime_error);
+
+	REQUIRE(visited == 1000);
+
+	REQUIRE_THROWS_AS(plexum::parallel_for(0, 1000, 4, 1, [](std::size_t, std::size_t, unsigned t) {
+		if (t == 0)
+			throw std::runtime_error("caller failed");
+	}), std::runtime_error);
+}
+
+TEST_CASE("binary snapshot files", "[csr_graph]")
+{
+	typedef plexum::Graph<int, double, plexum::slot_storage> graph;
+	typedef plexum::csr_graph<int, double> snapshot;
+	const char* path = "csr_test_snapshot.bin";
+
+	graph g;
+	std::vector<graph::vertex_proxy::iterator> v;
+
+	for (int i = 0; i < 100; i++)
+		v.push_back(g.vertices.add(i));
+
+	for (int i = 0; i < 400; i++)
+		g.edges.add(v[(i * 37) % 100], v[(i * 53 + 1) % 100], i * 0.5);
+
+	g.vertices.remove_with_edges(v[17]);
+	v[17] = g.vertices.add(1000);
+	g.edges.add(v[17], v[3], -1.0);
+
+	auto s = g.freeze();
+	s.save(path);
+
+	SECTION("an opened snapshot equals the saved one")
+	{
+		auto o = snapshot::open(path);
+
+		REQUIRE(o.vertex_count() == s.vertex_count());
+		REQUIRE(o.edge_count() == s.edge_count());
+		REQUIRE(o.offsets() == s.offsets());
+		REQUIRE(o.adjacency() == s.adjacency());
+		REQUIRE(o.adjacency_edges() == s.adjacency_edges());
+		REQUIRE(o.directed() == s.directed());
+
+		bool equal = true;
+
+		for (std::size_t u = 0; u < s.vertex_count(); u++)
+			equal &= o.vertex(u) == s.vertex(u) && o.vertex_id(u) == s.vertex_id(u);
+
+		for (std::size_t e = 0; e < s.edge_count(); e++)
+			equal &= o.edge(e) == s.edge(e) && o.edge_id(e) == s.edge_id(e)
+				&& o.source(e) == s.source(e) && o.target(e) == s.target(e);
+
+		REQUIRE(equal);
+		REQUIRE(o.vertex(o.vertex_index(v[17].id())) == 1000);
+		REQUIRE(o.vertex_index(v[42].id()) == s.vertex_index(v[42].id()));
+		REQUIRE(o.find_path(0, 50) == s.find_path(0, 50));
+		REQUIRE(o.bfs(0).level == s.bfs(0).level);
+	}
+
+	SECTION("copies of an opened snapshot outlive the original")
+	{
+		snapshot c;
+
+		{
+			auto o = snapshot::open(path);
+			c = o;
+		}
+
+		REQUIRE(c.adjacency() == s.adjacency());
+		REQUIRE(c.vertex(c.vertex_count() - 1) == s.vertex(s.vertex_count() - 1));
+	}
+
+	SECTION("an opened snapshot can be saved over its own file")
+	{
+		auto o = snapshot::open(path);
+		o.save(path);
+
+		REQUIRE(o.adjacency() == s.adjacency());
+		REQUIRE(o.vertex(o.vertex_count() - 1) == s.vertex(s.vertex_count() - 1));
+
+		auto r = snapshot::open(path);
+
+		REQUIRE(r.offsets() == s.offsets());
+		REQUIRE(r.adjacency() == s.adjacency());
+		REQUIRE(!std::ifstream(std::string(path) + ".tmp"));
+	}
+
+	SECTION("directed snapshots keep their direction")
+	{
+		plexum::Graph<int, int, plexum::map_storage, plexum::directed> d;
+		auto x = d.vertices.add(1);
+		auto y = d.vertices.add(2);
+		d.edges.add(x, y, 3);
+		d.freeze().save(path);
+
+		auto o = plexum::csr_graph<int, int>::open(path);
+
+		REQUIRE(o.directed());
+		REQUIRE(o.degree(0) == 1);
+		REQUIRE(o.degree(1) == 0);
+	}
+
+	SECTION("damaged files are rejected")
+	{
+		std::string bytes;
+
+		{
+			std::ifstream in(path, std::ios::binary);
+			bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+		}
+
+		auto rewrite = [&](const std::string& contents) {
+			std::ofstream out(path, std::ios::binary | std::ios::trunc);
+			out << contents;
+		};
+
+		rewrite(bytes.substr(0, bytes.size() / 2));
+		REQUIRE_THROWS_AS(snapshot::open(path), plexum::exception);
+
+		std::string other = bytes;
+		other[0] = 'X';
+		rewrite(other);
+		REQUIRE_THROWS_AS(snapshot::open(path), plexum::exception);
+
+		rewrite(bytes);
+		REQUIRE_THROWS_AS((plexum::csr_graph<int, int>::open(path)), plexum::exception);
+		REQUIRE_THROWS_AS(snapshot::open("csr_test_missing.bin"), plexum::exception);
+	}
+
+	std::remove(path);
+}
+
+TEST_CASE("multi-source distances on the snapshot", "[csr_graph]")
+{
+	plexum::Graph<std::size_t, std::size_t> g;
+	std::vector<plexum::Graph<std::size_t, std::size_t>::vertex_proxy::iterator> v;
+
+	for (std::size_t i = 0; i < 300; i++)
+		v.push_back(g.vertices.add(i));
+
+	for (std::size_t i = 0; i < 1500; i++)
+		g.edges.add(v[(i * 7919) % 300], v[(i * 104729 + 3) % 300], 1 + i % 13);
+
+	g.vertices.add(300);
+
+	auto s = g.freeze();
+	auto weight = [](const std::size_t* w) { return static_cast<double>(*w); };
+	auto all = [](const std::size_t*) { return true; };
+	std::vector<std::size_t> sources;
+
+	for (std::size_t i = 0; i < s.vertex_count(); i += 7)
+		sources.push_back(i);
+
+	SECTION("weighted rows agree with single-source searches and across thread counts")
+	{
+		auto m1 = s.distances(sources, weight, all, 1);
+		auto m4 = s.distances(sources, weight, all, 4);
+
+		REQUIRE(m1.rows == sources.size());
+		REQUIRE(m1.columns == s.vertex_count());
+		REQUIRE(m1.distance == m4.distance);
+
+		bool consistent = true;
+
+		for (std::size_t r = 0; r < m4.rows; r++) {
+			for (std::size_t t = 0; t < m4.columns; t++) {
+				std::size_t e = m4.predecessor_at(r, t);
+
+				if (t == sources[r]) {
+					consistent &= m4.at(r, t) == 0 && e == s.npos;
+				} else if (e == s.npos) {
+					consistent &= std::isinf(m4.at(r, t));
+				} else {
+					std::size_t u = s.source(e) == t ? s.target(e) : s.source(e);
+					consistent &= m4.at(r, t) == m4.at(r, u) + s.edge(e);
+				}
+			}
+		}
+
+		REQUIRE(consistent);
+		REQUIRE(std::isinf(m4.at(0, s.vertex_index(300))));
+	}
+
+	SECTION("hop rows match the length of breadth-first paths")
+	{
+		auto m = s.hop_distances(sources, all, 3);
+		bool consistent = true;
+
+		for (std::size_t r = 0; r < m.rows; r++)
+			for (std::size_t t = 0; t < 300; t += 11)
+				if (t != sources[r] && !std::isinf(m.at(r, t)))
+					consistent &= m.at(r, t) == s.find_path(sources[r], t).size();
+
+		REQUIRE(consistent);
+	}
+
+	SECTION("rows can be streamed instead of stored")
+	{
+		auto m = s.distances(sources, weight, all);
+		std::vector<double> streamed(m.distance.size());
+		std::vector<std::size_t> seen(sources.size(), 0);
+
+		s.distance_rows(sources, weight, all, [&](std::size_t r, const double* d, const std::size_t*) {
+			std::copy(d, d + s.vertex_count(), streamed.begin() + r * s.vertex_count());
+			seen[r]++;
+		}, 4);
+
+		REQUIRE(streamed == m.distance);
+		REQUIRE(std::count(seen.begin(), seen.end(), 1) == static_cast<long>(sources.size()));
+	}
+
+	SECTION("errors in worker threads reach the caller")
+	{
+		REQUIRE_THROWS_AS(s.distances(sources, [](const std::size_t* w) { return *w == 5 ? -1.0 : 1.0; },
+									  all, 4), plexum::exception);
+		REQUIRE_THROWS_AS(s.hop_distances(std::vector<std::size_t>(1, s.vertex_count()), all),
+						  plexum::exception);
+	}
+}
+
+TEST_CASE("direction-optimizing breadth-first search", "[csr_graph]")
+{
+	plexum::Graph<std::size_t, std::size_t> g;
+	std::vector<plexum::Graph<std::size_t, std::size_t>::vertex_proxy::iterator> v;
+
+	for (std::size_t i = 0; i < 40000; i++)
+		v.push_back(g.vertices.add(i));
+
+	// a long path keeps the search top-down, a dense random part makes it turn bottom-up
+	for (std::size_t i = 1; i < 2000; i++)
+		g.edges.add(v[i - 1], v[i], i);
+
+	std::minstd_rand rng(3);
+
+	for (std::size_t i = 0; i < 200000; i++)
+		g.edges.add(v[1999 + rng() % 37000], v[1999 + rng() % 37000], i);
+
+	auto s = g.freeze();
+	auto hops = s.hop_distances(std::vector<std::size_t>(1, 0), [](const std::size_t*) { return true; });
+
+	for (unsigned threads : {1u, 4u}) {
+		auto tree = s.bfs(0, threads);
+		bool consistent = true;
+		std::size_t reached = 0;
+
+		for (std::size_t u = 0; u < s.vertex_count(); u++) {
+			if (std::isinf(hops.at(0, u))) {
+				consistent &= tree.level[u] == s.npos && tree.parent_edge[u] == s.npos;
+				continue;
+			}
+
+			reached++;
+			consistent &= tree.level[u] == hops.at(0, u);
+
+			if (u != 0)
+				consistent &= tree.level[tree.parent(s, u)] + 1 == tree.level[u];
+		}
+
+		REQUIRE(consistent);
+		REQUIRE(tree.reached == reached);
+		REQUIRE(tree.parent(s, 0) == s.npos);
+		REQUIRE(tree.level[39999] == s.npos);
+	}
+
+	REQUIRE_THROWS_AS(s.bfs(s.vertex_count()), plexum::exception);
+}
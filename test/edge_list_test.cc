@@ -0,0 +1,109 @@
+#include <catch.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include <plexum/edge_list.h>
+
+namespace
+{
+	void write_file(const char* path, const std::string& contents)
+	{
+		std::ofstream out(path, std::ios::binary | std::ios::trunc);
+		out << contents;
+	}
+}
+
+TEST_CASE("edge list import", "[edge_list]")
+{
+	const char* path = "edge_list_test.txt";
+
+	SECTION("labels become vertices and lines become edges")
+	{
+		plexum::Graph<long, double> g;
+		write_file(path, "# a comment\n% another\n\n1000 7\t2.5\n7 42\n  42 1000 -1e-1 1234567\r\n1000 7");
+
+		auto ids = plexum::read_edge_list(g, path);
+
+		REQUIRE(g.vertices.count() == 3);
+		REQUIRE(g.edges.count() == 4);
+		REQUIRE(ids.size() == 3);
+		REQUIRE(*g.vertices[ids[1000]] == 1000);
+		REQUIRE(*g.vertices[ids[42]] == 42);
+		REQUIRE(*g.edges.between(g.vertices[ids[7]], g.vertices[ids[42]]) == 1.0);
+		REQUIRE(*g.edges.between(g.vertices[ids[1000]], g.vertices[ids[42]]) == Approx(-0.1));
+		REQUIRE(g.vertices[ids[7]].degree() == 3);
+	}
+
+	SECTION("parallel parsing matches sequential parsing")
+	{
+		std::stringstream ss;
+
+		for (std::size_t i = 0; i < 300000; i++)
+			ss << (i * 7919) % 5003 << ' ' << (i * 104729 + 1) % 4999 << ' ' << i % 10 << '\n';
+
+		write_file(path, ss.str());
+
+		plexum::Graph<std::size_t, int, plexum::slot_storage, plexum::directed> g1, g4;
+		auto ids1 = plexum::read_edge_list(g1, path, 1);
+		auto ids4 = plexum::read_edge_list(g4, path, 4);
+
+		REQUIRE(g1.edges.count() == 300000);
+		REQUIRE(g4.edges.count() == 300000);
+		REQUIRE(ids1 == ids4);
+
+		bool equal = true;
+
+		for (auto& p : ids1)
+			equal &= g1.vertices[p.second].degree() == g4.vertices[p.second].degree();
+
+		REQUIRE(equal);
+	}
+
+	SECTION("weights are parsed exactly like strtod")
+	{
+		const char* weights[] = {
+			"0.3", "0.7", "2.675", "3.14159", "-0.1", "+6.02214076e23", "1e-300", "4.9e-324",
+			"123.456e-5", "0.1e23", "9007199254740993", "12345678901234567890.5",
+			"1.7976931348623157e308", "0.000000000000000000000000000001"
+		};
+		const std::size_t n = sizeof(weights) / sizeof(weights[0]);
+		std::stringstream ss;
+
+		for (std::size_t i = 0; i < n; i++)
+			ss << i << ' ' << i + n << ' ' << weights[i] << '\n';
+
+		write_file(path, ss.str());
+
+		plexum::Graph<long, double> g;
+		auto ids = plexum::read_edge_list(g, path);
+		bool equal = true;
+
+		for (std::size_t i = 0; i < n; i++)
+			equal &= *g.edges.between(g.vertices[ids[i]], g.vertices[ids[i + n]])
+				== std::strtod(weights[i], nullptr);
+
+		REQUIRE(equal);
+	}
+
+	SECTION("malformed lines are reported and leave the graph unchanged")
+	{
+		plexum::Graph<int, int> g;
+
+		write_file(path, "1 2\n3 x\n");
+		REQUIRE_THROWS_WITH(plexum::read_edge_list(g, path), Catch::Contains("line 2"));
+
+		write_file(path, "1 2\n3\n");
+		REQUIRE_THROWS_AS(plexum::read_edge_list(g, path), plexum::exception);
+
+		write_file(path, "1 2 3.5.1\n");
+		REQUIRE_THROWS_AS(plexum::read_edge_list(g, path), plexum::exception);
+
+		REQUIRE(g.vertices.count() == 0);
+		REQUIRE_THROWS_AS(plexum::read_edge_list(g, "edge_list_test_missing.txt"), plexum::exception);
+	}
+
+	std::remove(path);
+}
@@ -0,0 +1,162 @@
+#include <catch.h>
+
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <plexum/graph_builder.h>
+
+typedef plexum::Graph<int, int, plexum::slot_storage> graph;
+typedef plexum::graph_builder<int, int, plexum::slot_storage> builder;
+
+// an edge value whose negative copies throw while *armed* is set
+class flaky {
+public:
+	flaky(int i) : i(i) { }
+	flaky(const flaky& other) : i(other.i)
+	{
+		if (armed && i < 0)
+			throw std::runtime_error("flaky: copy failed");
+	}
+	int i;
+	static bool armed;
+};
+
+bool flaky::armed = false;
+
+TEST_CASE("graph builder", "[graph_builder]")
+{
+	graph g;
+	builder b(g);
+
+	SECTION("recorded vertices and edges are added on commit")
+	{
+		auto& s = b.make_shard();
+		auto& t = b.make_shard();
+
+		std::size_t v0 = s.add_vertex(0);
+		std::size_t v1 = s.add_vertex(1);
+		std::size_t v2 = t.add_vertex(2);
+
+		s.add_edge(v0, v1, 10);
+		t.add_edge(v1, v2, 20);
+
+		REQUIRE(v0 != v2);
+		REQUIRE(s.vertex_count() == 2);
+		REQUIRE(t.edge_count() == 1);
+		REQUIRE(g.vertices.count() == 0);
+
+		auto ids = b.commit();
+
+		REQUIRE(g.vertices.count() == 3);
+		REQUIRE(g.edges.count() == 2);
+		REQUIRE(*g.vertices[ids[v2]] == 2);
+		REQUIRE(*g.edges.between(g.vertices[ids[v0]], g.vertices[ids[v1]]) == 10);
+		REQUIRE(g.find_path(g.vertices[ids[v0]], g.vertices[ids[v2]]).size() == 2);
+		REQUIRE(s.vertex_count() == 0);
+		REQUIRE(t.edge_count() == 0);
+	}
+
+	SECTION("shards connect to vertices already in the graph")
+	{
+		auto a = g.vertices.add(7);
+		auto& s = b.make_shard();
+
+		std::size_t v = s.add_vertex(8);
+		s.add_edge(s.vertex(a.id()), v, 1);
+		b.commit();
+
+		REQUIRE(g.vertices.count() == 2);
+		REQUIRE(a.degree() == 1);
+
+		// shards are reused after a commit
+		s.add_edge(s.vertex(a.id()), s.add_vertex(9), 2);
+		b.commit();
+
+		REQUIRE(a.degree() == 2);
+	}
+
+	SECTION("invalid tickets leave the graph unchanged")
+	{
+		auto& s = b.make_shard();
+
+		s.add_edge(s.add_vertex(0), 123456, 1);
+
+		REQUIRE_THROWS_AS(b.commit(), plexum::exception);
+		REQUIRE(g.vertices.count() == 0);
+
+		auto& t = b.make_shard();
+		auto a = g.vertices.add(1);
+		std::size_t bound = t.vertex(a.id());
+		g.vertices.remove(a);
+		t.add_edge(bound, bound, 1);
+
+		REQUIRE_THROWS_AS(b.commit(), plexum::exception);
+		REQUIRE(g.vertices.count() == 0);
+		REQUIRE(g.edges.count() == 0);
+	}
+
+	SECTION("a throwing edge value keeps the shards for another commit")
+	{
+		plexum::Graph<int, flaky, plexum::slot_storage> h;
+		plexum::graph_builder<int, flaky, plexum::slot_storage> c(h);
+		auto a = h.vertices.add(7);
+		auto& s = c.make_shard();
+
+		std::size_t v0 = s.add_vertex(0);
+		std::size_t v1 = s.add_vertex(1);
+		s.add_edge(v0, v1, flaky(1));
+		s.add_edge(s.vertex(a.id()), v1, flaky(-1));
+
+		flaky::armed = true;
+		REQUIRE_THROWS_AS(c.commit(), std::runtime_error);
+		flaky::armed = false;
+
+		REQUIRE(h.vertices.count() == 1);
+		REQUIRE(h.edges.count() == 0);
+		REQUIRE(a.degree() == 0);
+		REQUIRE(s.vertex_count() == 2);
+		REQUIRE(s.edge_count() == 2);
+
+		auto ids = c.commit();
+
+		REQUIRE(h.vertices.count() == 3);
+		REQUIRE(h.edges.count() == 2);
+		REQUIRE(h.edges.between(a, h.vertices[ids[v1]])->i == -1);
+		REQUIRE(s.edge_count() == 0);
+	}
+
+	SECTION("threads fill their own shards")
+	{
+		const int threads = 4;
+		const int n = 3000;
+		std::vector<std::thread> workers;
+		std::vector<builder::shard*> shards;
+
+		for (int i = 0; i < threads; i++)
+			shards.push_back(&b.make_shard());
+
+		// every thread builds a path over its own vertices
+		for (int i = 0; i < threads; i++) {
+			workers.emplace_back([&shards, i, n] {
+				builder::shard& s = *shards[i];
+				std::size_t last = s.add_vertex(i * n);
+
+				for (int j = 1; j < n; j++) {
+					std::size_t next = s.add_vertex(i * n + j);
+					s.add_edge(last, next, j);
+					last = next;
+				}
+			});
+		}
+
+		for (auto& w : workers)
+			w.join();
+
+		b.commit(2);
+
+		REQUIRE(g.vertices.count() == threads * n);
+		REQUIRE(g.edges.count() == threads * (n - 1));
+		REQUIRE(g.component_count() == threads);
+	}
+}
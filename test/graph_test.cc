@@ -1,5 +1,13 @@
 #include <catch.h>
 
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <tuple>
+
 #include <plexum/graph.h>
 
 class V {
@@ -17,6 +25,38 @@ public:
 	double weight;
 };
 
+// an edge value whose copies throw once *fail* is set on the original
+class F {
+public:
+	F(int i) : i(i), fail(false) { }
+	F(const F& other) : i(other.i), fail(false)
+	{
+		if (other.fail)
+			throw std::runtime_error("F: copy failed");
+	}
+	int i;
+	bool fail;
+};
+
+// checks that every edge is in the out-list of its source and that the in-degrees add up
+template<class G>
+bool directed_adjacency_consistent(G& g)
+{
+	std::size_t out = 0, in = 0;
+	bool ok = true;
+
+	for (auto i = g.vertices.begin(); i != g.vertices.end(); ++i) {
+		auto r = i.edge_view();
+
+		for (auto e = r.begin(); e != r.end(); ++e, out++)
+			ok &= e.edge().from() == i;
+
+		in += i.in_degree();
+	}
+
+	return ok && out == g.edges.count() && in == g.edges.count();
+}
+
 TEST_CASE("graph vertices and edges", "[Graph]")
 {
 	plexum::Graph<int, int> g1;
@@ -98,6 +138,65 @@ TEST_CASE("graph vertices and edges", "[Graph]")
 		REQUIRE_THROWS(g1.edges.between(g1.vertices[0], g1.vertices[2]));
 	}
 
+	SECTION("edge lookup through a vertex pair stays consistent when edges are added and removed")
+	{
+		auto v1 = g1.vertices.add(1);
+		auto v2 = g1.vertices.add(2);
+		auto v3 = g1.vertices.add(3);
+		auto e1 = g1.edges.add(v1, v2, 1);
+		auto e2 = g1.edges.add(v1, v2, 2);
+		auto e3 = g1.edges.add(v1, v3, 3);
+		auto e4 = g1.edges.add(v3, v3, 4);
+
+		REQUIRE(g1.edges.between(v2, v1) == e1);
+		REQUIRE(g1.edges.between(v3, v1) == e3);
+		REQUIRE(g1.edges.between(v3, v3) == e4);
+
+		g1.edges.remove(e1);
+		REQUIRE(g1.edges.between(v1, v2) == e2);
+
+		g1.edges.remove(e2);
+		REQUIRE_THROWS(g1.edges.between(v1, v2));
+
+		auto e5 = g1.edges.add(v2, v1, 5);
+		REQUIRE(g1.edges.between(v1, v2) == e5);
+		REQUIRE(g1.edges.between(v1, v3) == e3);
+	}
+
+	SECTION("adjacency stays consistent when edges touching a hub are removed in any order")
+	{
+		std::vector<plexum::Graph<int, int>::vertex_proxy::iterator> v;
+		std::vector<plexum::Graph<int, int>::edge_proxy::iterator> e;
+
+		for (int i = 0; i < 20; i++)
+			v.push_back(g1.vertices.add(i));
+
+		for (int i = 0; i < 200; i++)
+			e.push_back(g1.edges.add(v[i % 3 == 0 ? 0 : i % 20], v[(i * 7) % 20], i));
+
+		for (std::size_t i = 0; i < e.size(); i += 1 + i % 3)
+			g1.edges.remove(e[i]);
+
+		std::multiset<std::size_t> expected, actual;
+
+		for (auto i = g1.edges.begin(); i != g1.edges.end(); ++i) {
+			expected.insert(i.from().id() * 1000 + i.id());
+			expected.insert(i.to().id() * 1000 + i.id());
+		}
+
+		for (auto i = g1.vertices.begin(); i != g1.vertices.end(); ++i)
+			for (auto n = i.edge_view().begin(); n != i.edge_view().end(); ++n)
+				actual.insert(i.id() * 1000 + n.id());
+
+		REQUIRE(actual == expected);
+
+		while (g1.edges.count() > 0)
+			g1.edges.remove(g1.edges.begin());
+
+		REQUIRE(v[0].degree() == 0);
+		REQUIRE_NOTHROW(g1.vertices.remove(v[0]));
+	}
+
 	SECTION("vertex.neighbors() returns iterators to neighbor vertices")
 	{
 		auto v1 = g1.vertices.add(1);
@@ -151,6 +250,165 @@ TEST_CASE("graph vertices and edges", "[Graph]")
 		REQUIRE(g1.edges.count() == 0);
 	}
 
+	SECTION("vertices can be removed with their edges one at a time or in batches")
+	{
+		std::vector<plexum::Graph<int, int>::vertex_proxy::iterator> v;
+
+		for (int i = 0; i < 12; i++)
+			v.push_back(g1.vertices.add(i));
+
+		// a hub with self-loop and parallel edges, a ring and a chord between removed vertices
+		for (int i = 1; i < 12; i++)
+			g1.edges.add(v[0], v[i], i);
+
+		g1.edges.add(v[0], v[0], 100);
+		g1.edges.add(v[0], v[5], 101);
+
+		for (int i = 1; i < 12; i++)
+			g1.edges.add(v[i], v[i % 11 + 1], 200 + i);
+
+		g1.edges.add(v[3], v[7], 300);
+
+		REQUIRE_NOTHROW(g1.vertices.remove_with_edges(v[0]));
+		REQUIRE(g1.vertices.count() == 11);
+		REQUIRE(g1.edges.count() == 12);
+		REQUIRE(v[5].degree() == 2);
+
+		g1.vertices.remove_with_edges({v[3], v[7], v[9], v[3]});
+
+		REQUIRE(g1.vertices.count() == 8);
+		REQUIRE(g1.edges.count() == 5);
+		REQUIRE(v[2].neighbors().size() == 1);
+		REQUIRE(v[2].neighbors()[0] == v[1]);
+		REQUIRE(v[8].degree() == 0);
+		REQUIRE(v[10].edges()[0] == g1.edges.between(v[10], v[11]));
+
+		std::size_t entries = 0;
+
+		for (auto i = g1.vertices.begin(); i != g1.vertices.end(); ++i)
+			for (auto e : i.edges())
+				entries += e.from() == i || e.to() == i;
+
+		REQUIRE(entries == 10);
+
+		g1.edges.remove(g1.edges.between(v[1], v[2]));
+		REQUIRE(v[2].degree() == 0);
+		REQUIRE(v[1].degree() == 1);
+	}
+
+	SECTION("vertices and edges can be added in bulk")
+	{
+		std::vector<int> values;
+
+		for (int i = 0; i < 100; i++)
+			values.push_back(i);
+
+		auto v0 = g1.vertices.add(-1);
+		auto ids = g1.vertices.add_range(values.begin(), values.end());
+
+		REQUIRE(ids.size() == 100);
+		REQUIRE(*g1.vertices[ids[42]] == 42);
+
+		std::vector<std::tuple<std::size_t, std::size_t, int>> links;
+
+		for (int i = 0; i < 300; i++)
+			links.push_back(std::make_tuple(ids[i % 100], i % 7 == 0 ? ids[i % 100] : ids[(i * 13) % 100], i));
+
+		g1.edges.add(v0, g1.vertices[ids[5]], -1);
+		g1.edges.add_range(links.begin(), links.end(), 2);
+
+		REQUIRE(g1.edges.count() == 301);
+		REQUIRE(*g1.edges.between(g1.vertices[ids[1]], g1.vertices[ids[13]]) == 1);
+
+		std::multiset<std::size_t> expected, actual;
+
+		for (auto i = g1.edges.begin(); i != g1.edges.end(); ++i) {
+			expected.insert(i.from().id() * 1000 + i.id());
+			expected.insert(i.to().id() * 1000 + i.id());
+		}
+
+		for (auto i = g1.vertices.begin(); i != g1.vertices.end(); ++i)
+			for (auto n = i.edge_view().begin(); n != i.edge_view().end(); ++n)
+				actual.insert(i.id() * 1000 + n.id());
+
+		REQUIRE(actual == expected);
+
+		g1.vertices.remove_with_edges(g1.vertices[ids[5]]);
+		REQUIRE(v0.degree() == 0);
+
+		links.push_back(std::make_tuple(ids[0], ids[5], 0));
+		REQUIRE_THROWS_AS(g1.edges.add_range(links.begin(), links.end()), plexum::exception);
+		REQUIRE(g1.edges.count() == 301 - 1 - 6);
+
+		std::vector<std::tuple<std::size_t, std::size_t, int>> few;
+		few.push_back(std::make_tuple(ids[1], ids[2], 1000));
+		few.push_back(std::make_tuple(ids[2], ids[2], 1001));
+		g1.edges.add_range(few.begin(), few.end());
+
+		REQUIRE(g1.edges.count() == 301 - 1 - 6 + 2);
+		REQUIRE(*g1.edges.between(g1.vertices[ids[2]], g1.vertices[ids[1]]) == 1000);
+		REQUIRE(*g1.edges.between(g1.vertices[ids[2]], g1.vertices[ids[2]]) == 1001);
+
+		few.push_back(std::make_tuple(ids[5], ids[1], 1002));
+		REQUIRE_THROWS_AS(g1.edges.add_range(few.begin(), few.end()), plexum::exception);
+		REQUIRE(g1.edges.count() == 301 - 1 - 6 + 2);
+	}
+
+	SECTION("bulk edge insertion leaves the graph unchanged if an edge value throws")
+	{
+		plexum::Graph<int, F> u;
+		plexum::Graph<int, F, plexum::map_storage, plexum::directed> d;
+		std::vector<int> values = {0, 1, 2, 3, 4};
+		auto uv = u.vertices.add_range(values.begin(), values.begin() + 2);
+		auto dv = d.vertices.add_range(values.begin(), values.end());
+
+		// dense pass, as the range is larger than the graph
+		std::vector<std::tuple<std::size_t, std::size_t, F>> dense;
+		dense.push_back(std::make_tuple(uv[0], uv[1], F(0)));
+		dense.push_back(std::make_tuple(uv[1], uv[0], F(1)));
+		dense.push_back(std::make_tuple(uv[0], uv[0], F(2)));
+		std::get<2>(dense[2]).fail = true;
+
+		u.edges.add(u.vertices[uv[0]], u.vertices[uv[1]], F(-1));
+		REQUIRE_THROWS_AS(u.edges.add_range(dense.begin(), dense.end()), std::runtime_error);
+		REQUIRE(u.edges.count() == 1);
+		REQUIRE(u.vertices[uv[0]].degree() == 1);
+		REQUIRE(u.vertices[uv[1]].neighbors().size() == 1);
+		REQUIRE(u.vertices[uv[1]].neighbors()[0] == u.vertices[uv[0]]);
+
+		std::get<2>(dense[2]).fail = false;
+		u.edges.add_range(dense.begin(), dense.end());
+		REQUIRE(u.edges.count() == 4);
+		REQUIRE(u.vertices[uv[0]].degree() == 5);
+
+		// edge by edge, as the range is smaller than the graph
+		std::vector<std::tuple<std::size_t, std::size_t, F>> few;
+		few.reserve(5);
+		few.push_back(std::make_tuple(dv[0], dv[1], F(0)));
+		few.push_back(std::make_tuple(dv[2], dv[1], F(1)));
+		few.push_back(std::make_tuple(dv[3], dv[1], F(2)));
+		std::get<2>(few[2]).fail = true;
+
+		REQUIRE_THROWS_AS(d.edges.add_range(few.begin(), few.end()), std::runtime_error);
+		REQUIRE(d.edges.count() == 0);
+		REQUIRE(d.vertices[dv[1]].in_degree() == 0);
+		REQUIRE(d.vertices[dv[0]].degree() == 0);
+		REQUIRE(!d.connected(d.vertices[dv[0]], d.vertices[dv[1]]));
+
+		// dense pass of a directed graph, whose targets only count their in-degree
+		few.push_back(std::make_tuple(dv[4], dv[1], F(3)));
+		few.push_back(std::make_tuple(dv[4], dv[0], F(4)));
+		REQUIRE_THROWS_AS(d.edges.add_range(few.begin(), few.end()), std::runtime_error);
+		REQUIRE(d.edges.count() == 0);
+		REQUIRE(d.vertices[dv[1]].in_degree() == 0);
+		REQUIRE(directed_adjacency_consistent(d));
+
+		std::get<2>(few[2]).fail = false;
+		d.edges.add_range(few.begin(), few.end());
+		REQUIRE(d.vertices[dv[1]].in_degree() == 4);
+		REQUIRE(directed_adjacency_consistent(d));
+	}
+
 	SECTION("edges can be removed")
 	{
 		auto v1 = g1.vertices.add(1);
@@ -164,6 +422,61 @@ TEST_CASE("graph vertices and edges", "[Graph]")
 	}
 }
 
+TEST_CASE("neighbor and incident edge views", "[Graph]")
+{
+	plexum::Graph<V, E> g;
+
+	auto v1 = g.vertices.add(1);
+	auto v2 = g.vertices.add(2);
+	auto v3 = g.vertices.add(3);
+	auto v4 = g.vertices.add(4);
+	auto e1 = g.edges.add(v1, v2, {10, 1});
+	auto e2 = g.edges.add(v3, v1, {20, 1});
+	g.edges.add(v2, v3, {30, 1});
+
+	SECTION("views yield neighbors and edges in place")
+	{
+		auto n = v1.neighbor_view();
+		auto i = n.begin();
+
+		REQUIRE(v1.degree() == 2);
+		REQUIRE(n.size() == 2);
+		REQUIRE(i->i == 2);
+		REQUIRE(i.id() == v2.id());
+		REQUIRE(i.edge_element().i == 10);
+		REQUIRE(i.edge_id() == e1.id());
+		REQUIRE(i.vertex() == v2);
+		REQUIRE(i.edge() == e1);
+		REQUIRE((*++i).i == 3);
+		REQUIRE(++i == n.end());
+
+		std::vector<unsigned long> incident;
+
+		for (E& e : v1.edge_view())
+			incident.push_back(e.i);
+
+		REQUIRE(incident == std::vector<unsigned long>({10, 20}));
+		REQUIRE(v1.edge_view().begin().edge() == e1);
+		REQUIRE(v4.degree() == 0);
+		REQUIRE(v4.neighbor_view().empty());
+		REQUIRE(v4.edge_view().begin() == v4.edge_view().end());
+	}
+
+	SECTION("the vector-returning accessors agree with the views")
+	{
+		g.edges.remove(e2);
+
+		auto n = v1.neighbors();
+		auto e = v1.edges();
+
+		REQUIRE(v1.degree() == 1);
+		REQUIRE(n.size() == 1);
+		REQUIRE(n[0] == v2);
+		REQUIRE(e.size() == 1);
+		REQUIRE(e[0] == e1);
+	}
+}
+
 TEST_CASE("internal id management", "[Graph]")
 {
 	plexum::Graph<int, int> g;
@@ -401,6 +714,532 @@ TEST_CASE("sub and super graphs", "[Graph]")
 		REQUIRE(g2.edges[0].sub_edges().empty());
 		REQUIRE(g2.edges[0].super_edge().empty());
 	}
+
+	SECTION("subgraphs are unmapped in any order")
+	{
+		g1.map(&g2);
+		g1.map(&g3);
+		g1.unmap(&g2);
+
+		REQUIRE(!g1.has_subgraph(&g2));
+		REQUIRE(g1.has_subgraph(&g3));
+		REQUIRE(g1.subgraphs().size() == 1);
+
+		g2.map(&g3);
+
+		REQUIRE(!g1.has_subgraphs());
+		REQUIRE(g2.has_subgraph(&g3));
+		REQUIRE(g3.supergraph() == &g2);
+	}
+
+	SECTION("substrate vertices and edges keep count and load of their mappings")
+	{
+		g1.set_demand([](int v) { return 10.0 * v; }, [](int e) { return 0.5 * e; });
+
+		auto s0 = g1.vertices.add(0);
+		auto s1 = g1.vertices.add(1);
+		auto s2 = g1.vertices.add(2);
+		auto se1 = g1.edges.add(s0, s1, 0);
+		auto se2 = g1.edges.add(s1, s2, 0);
+
+		std::vector<plexum::Graph<int, int>::vertex_proxy::iterator> v2, v3;
+
+		for (int i = 1; i <= 3; i++) {
+			v2.push_back(g2.vertices.add(i));
+			v3.push_back(g3.vertices.add(i));
+			s0.map(v2.back());
+			s0.map(v3.back());
+		}
+
+		REQUIRE(s0.sub_vertex_count() == 6);
+		REQUIRE(s0.load() == Approx(120));
+
+		s0.unmap(v2[0]);
+		v3[2].unmap_from_super_vertex();
+		s1.map(v2[1]);
+
+		REQUIRE(s0.sub_vertex_count() == 3);
+		REQUIRE(s0.load() == Approx(60));
+		REQUIRE(s1.sub_vertex_count() == 1);
+		REQUIRE(s1.load() == Approx(20));
+		REQUIRE(v2[1].super_vertex() == s1._ptr());
+		REQUIRE_THROWS(s0.unmap(v2[1]));
+
+		std::set<int*> sitting;
+		for (int* p : s0.sub_vertices())
+			sitting.insert(p);
+
+		REQUIRE(sitting == std::set<int*>{v2[2]._ptr(), v3[0]._ptr(), v3[1]._ptr()});
+
+		auto l2 = g2.edges.add(v2[0], v2[1], 4);
+		auto l3 = g3.edges.add(v3[0], v3[1], 6);
+
+		se1.map_path(l2);
+		se2.map_path(l2);
+		se2.map_link(l3);
+
+		REQUIRE(se1.sub_edge_count() == 1);
+		REQUIRE(se2.sub_edge_count() == 2);
+		REQUIRE(se2.load() == Approx(5));
+		REQUIRE(l2.super_edge() == std::vector<int*>{se1._ptr(), se2._ptr()});
+
+		se1.unmap(l2);
+
+		REQUIRE(l2.super_edge() == std::vector<int*>{se2._ptr()});
+		REQUIRE(se1.load() == 0);
+		REQUIRE(se2.sub_edges() == std::vector<int*>{l2._ptr(), l3._ptr()});
+
+		se1.map_link(l3);
+
+		REQUIRE(se2.sub_edges() == std::vector<int*>{l2._ptr()});
+		REQUIRE(se2.load() == Approx(2));
+		REQUIRE(se1.load() == Approx(3));
+
+		l2.unmap_from_super_edge();
+
+		REQUIRE(!se2.has_subedges());
+		REQUIRE(se2.load() == 0);
+		REQUIRE(!l2.has_superedge());
+	}
+
+	SECTION("removed vertices and edges release their mappings")
+	{
+		g1.set_demand([](int v) { return 1.0 * v; }, [](int e) { return 1.0 * e; });
+
+		auto s0 = g1.vertices.add(0);
+		auto s1 = g1.vertices.add(1);
+		auto s2 = g1.vertices.add(2);
+		auto se1 = g1.edges.add(s0, s1, 0);
+		auto se2 = g1.edges.add(s1, s2, 0);
+
+		auto r1 = g2.vertices.add(1);
+		auto r2 = g2.vertices.add(2);
+		auto r3 = g2.vertices.add(3);
+		auto r4 = g2.vertices.add(4);
+		auto l1 = g2.edges.add(r1, r2, 2);
+		auto l2 = g2.edges.add(r2, r3, 3);
+
+		s1.map(r1);
+		s1.map(r2);
+		s1.map(r3);
+		s2.map(r4);
+		se1.map_path(l1);
+		se2.map_path(l1);
+		se2.map_path(l2);
+
+		REQUIRE(s1.load() == Approx(6));
+		REQUIRE(se2.load() == Approx(5));
+
+		g2.vertices.remove_with_edges(r2);
+		g2.vertices.remove(r3);
+
+		REQUIRE(s1.sub_vertex_count() == 1);
+		REQUIRE(s1.load() == Approx(1));
+		REQUIRE(!se1.has_subedges());
+		REQUIRE(!se2.has_subedges());
+		REQUIRE(se2.load() == 0);
+
+		s1.unmap(r1);
+
+		REQUIRE(!s1.has_subvertices());
+		REQUIRE(s1.load() == 0);
+
+		auto l3 = g2.edges.add(r1, r4, 4);
+		se1.map_path(l3);
+		se2.map_path(l3);
+		s1.map(r1);
+
+		g1.edges.remove(se1);
+
+		REQUIRE(l3.super_edge() == std::vector<int*>{se2._ptr()});
+		REQUIRE(se2.load() == Approx(4));
+
+		g1.vertices.remove_with_edges(s1);
+
+		REQUIRE(!r1.has_supervertex());
+		REQUIRE(!l3.has_superedge());
+		REQUIRE_NOTHROW(l3.unmap_from_super_edge());
+
+		g1.vertices.remove_with_edges(std::vector<decltype(s2)>{s0, s2});
+
+		REQUIRE(!r4.has_supervertex());
+		REQUIRE(g1.vertices.count() == 0);
+	}
+
+	SECTION("batch removals release the mappings of removed vertices and edges")
+	{
+		auto s0 = g1.vertices.add(0);
+		auto s1 = g1.vertices.add(1);
+		auto se = g1.edges.add(s0, s1, 0);
+
+		auto r0 = g2.vertices.add(1);
+		auto r1 = g2.vertices.add(2);
+		auto r2 = g2.vertices.add(3);
+		auto l0 = g2.edges.add(r0, r1, 1);
+		auto l1 = g2.edges.add(r1, r2, 2);
+
+		s0.map(r0);
+		s0.map(r1);
+		s1.map(r2);
+		se.map_path(l0);
+		se.map_path(l1);
+
+		g2.vertices.remove_with_edges(std::vector<decltype(r0)>{r0, r1});
+
+		REQUIRE(s0.sub_vertex_count() == 0);
+		REQUIRE(s0.load() == 0);
+		REQUIRE(s1.sub_vertex_count() == 1);
+		REQUIRE(!se.has_subedges());
+		REQUIRE(se.load() == 0);
+
+		s1.unmap(r2);
+
+		REQUIRE(!s1.has_subvertices());
+	}
+}
+
+TEST_CASE("virtual network embedding", "[Graph]")
+{
+	typedef plexum::Graph<int, int> graph;
+
+	// a ring of four substrate vertices with capacity 10 each and links of capacity 5, and a
+	// chord 0 - 2 of capacity 1
+	graph substrate;
+	std::vector<graph::vertex_proxy::iterator> s;
+	std::vector<graph::edge_proxy::iterator> se;
+
+	for (int i = 0; i < 4; i++)
+		s.push_back(substrate.vertices.add(10));
+
+	for (int i = 0; i < 4; i++)
+		se.push_back(substrate.edges.add(s[i], s[(i + 1) % 4], 5));
+
+	auto chord = substrate.edges.add(s[0], s[2], 1);
+
+	substrate.set_demand([](int cpu) { return cpu; }, [](int bw) { return bw; });
+
+	auto capacity = [](int c) { return c; };
+
+	SECTION("requests are placed and routed within the residual capacities")
+	{
+		graph request;
+		auto a = request.vertices.add(6);
+		auto b = request.vertices.add(4);
+		auto c = request.vertices.add(7);
+		auto ab = request.edges.add(a, b, 3);
+		auto bc = request.edges.add(b, c, 1);
+
+		REQUIRE(substrate.embed(&request, capacity, capacity));
+		REQUIRE(substrate.has_subgraph(&request));
+		REQUIRE(a.has_supervertex());
+		REQUIRE(a.super_vertex() != b.super_vertex());
+		REQUIRE(a.super_vertex() != c.super_vertex());
+		REQUIRE(b.super_vertex() != c.super_vertex());
+		REQUIRE(ab.has_superedge());
+		REQUIRE(bc.has_superedge());
+
+		double vertex_load = 0, edge_load = 0;
+		bool within = true;
+
+		for (auto& v : s) {
+			vertex_load += v.load();
+			within &= v.load() <= *v;
+		}
+
+		for (auto e = substrate.edges.begin(); e != substrate.edges.end(); ++e) {
+			edge_load += e.load();
+			within &= e.load() <= *e;
+		}
+
+		REQUIRE(within);
+		REQUIRE(vertex_load == 17);
+		REQUIRE(edge_load == 3 * ab.super_edge().size() + bc.super_edge().size());
+
+		// the 3 unit link cannot use the chord
+		for (int* p : ab.super_edge())
+			REQUIRE(p != chord._ptr());
+
+		substrate.unembed(&request);
+
+		REQUIRE(!substrate.has_subgraphs());
+		REQUIRE(!a.has_supervertex());
+		REQUIRE(!ab.has_superedge());
+		REQUIRE(s[0].load() + s[1].load() + s[2].load() + s[3].load() == 0);
+		REQUIRE(!se[0].has_subedges());
+	}
+
+	SECTION("embedded vertices leave their previous super vertex")
+	{
+		graph other;
+		auto x = other.vertices.add(10);
+		other.set_demand([](int cpu) { return cpu; }, [](int bw) { return bw; });
+
+		graph request;
+		auto a = request.vertices.add(3);
+		x.map(a);
+
+		REQUIRE(x.sub_vertex_count() == 1);
+		REQUIRE(substrate.embed(&request, capacity, capacity));
+		REQUIRE(x.sub_vertex_count() == 0);
+		REQUIRE(x.load() == 0);
+		REQUIRE(a.has_supervertex());
+	}
+
+	SECTION("edges are routed on the shortest path that fits their demand")
+	{
+		graph request;
+		auto a = request.vertices.add(9);
+		auto b = request.vertices.add(3);
+		auto c = request.vertices.add(2);
+		request.edges.add(a, b, 3);
+		auto ac = request.edges.add(a, c, 1);
+
+		REQUIRE(substrate.embed(&request, capacity, capacity));
+
+		// the route of the 3 unit link from the host of a excludes the chord, the 1 unit link
+		// may take it
+		REQUIRE(ac.super_edge().size() == 1);
+		REQUIRE(ac.super_edge()[0] == chord._ptr());
+	}
+
+	SECTION("requests that do not fit leave the substrate unchanged")
+	{
+		graph big;
+		big.vertices.add(11);
+
+		REQUIRE(!substrate.embed(&big, capacity, capacity));
+
+		graph wide;
+		auto a = wide.vertices.add(1);
+		auto b = wide.vertices.add(1);
+		wide.edges.add(a, b, 6);
+
+		REQUIRE(!substrate.embed(&wide, capacity, capacity));
+		REQUIRE(!substrate.has_subgraphs());
+		REQUIRE(!a.has_supervertex());
+
+		graph five;
+		for (int i = 0; i < 5; i++)
+			five.vertices.add(1);
+
+		REQUIRE(!substrate.embed(&five, capacity, capacity));
+		REQUIRE(s[0].load() == 0);
+	}
+
+	SECTION("residual capacity is shared by successive requests")
+	{
+		std::vector<std::unique_ptr<graph>> requests;
+		std::size_t accepted = 0;
+
+		for (int r = 0; r < 10; r++) {
+			requests.emplace_back(new graph);
+			auto a = requests.back()->vertices.add(2);
+			auto b = requests.back()->vertices.add(2);
+			requests.back()->edges.add(a, b, 2);
+			accepted += substrate.embed(requests.back().get(), capacity, capacity);
+		}
+
+		// the vertices admit all 10 requests, the 20 units of link capacity at least 4
+		REQUIRE(accepted >= 4);
+
+		bool within = true;
+
+		for (auto e = substrate.edges.begin(); e != substrate.edges.end(); ++e)
+			within &= e.load() <= *e;
+
+		REQUIRE(within);
+		REQUIRE_THROWS_AS(substrate.embed(requests[0].get(), capacity, capacity), plexum::exception);
+	}
+}
+
+TEST_CASE("connectivity index", "[Graph]")
+{
+	plexum::Graph<int, int, plexum::slot_storage> g;
+	std::vector<plexum::Graph<int, int, plexum::slot_storage>::vertex_proxy::iterator> v;
+
+	for (int i = 0; i < 6; i++)
+		v.push_back(g.vertices.add(i));
+
+	auto e01 = g.edges.add(v[0], v[1], 1);
+	g.edges.add(v[1], v[2], 1);
+	g.edges.add(v[3], v[4], 1);
+
+	SECTION("components follow added edges")
+	{
+		REQUIRE(g.connected(v[0], v[2]));
+		REQUIRE(!g.connected(v[0], v[3]));
+		REQUIRE(g.component(v[3]) == g.component(v[4]));
+		REQUIRE(g.component_count() == 3);
+
+		g.edges.add(v[2], v[3], 1);
+
+		REQUIRE(g.connected(v[0], v[4]));
+		REQUIRE(g.component_count() == 2);
+
+		std::vector<std::tuple<std::size_t, std::size_t, int>> range;
+		range.push_back(std::make_tuple(v[4].id(), v[5].id(), 1));
+		g.edges.add_range(range.begin(), range.end());
+
+		REQUIRE(g.connected(v[0], v[5]));
+		REQUIRE(g.component_count() == 1);
+	}
+
+	SECTION("removals are picked up by the next query")
+	{
+		REQUIRE(g.connected(v[0], v[2]));
+
+		g.edges.remove(e01);
+
+		REQUIRE(!g.connected(v[0], v[2]));
+		REQUIRE(g.component_count() == 4);
+
+		g.vertices.remove_with_edges(v[1]);
+		g.vertices.remove(v[5]);
+		auto w = g.vertices.add(7);
+
+		REQUIRE(g.component_count() == 4);
+		REQUIRE(!g.connected(w, v[2]));
+
+		g.edges.add(w, v[2], 1);
+
+		REQUIRE(g.connected(w, v[2]));
+		REQUIRE(g.component_count() == 3);
+	}
+
+	SECTION("path searches fail fast between components")
+	{
+		g.connected(v[0], v[0]);
+
+		REQUIRE_THROWS_AS(g.find_path(v[0], v[4]), plexum::exception);
+		REQUIRE_THROWS_AS(g.shortest_path(v[0], v[4], [](int* w) { return *w; }), plexum::exception);
+		REQUIRE_THROWS_AS(g.find_path(v[0], v[4], [](int*) { return true; },
+									  plexum::bidirectional_search()), plexum::exception);
+		REQUIRE(g.find_path(v[0], v[2]).size() == 2);
+
+		// a stale index does not prevent a search
+		g.edges.remove(e01);
+		g.edges.add(v[0], v[4], 1);
+
+		REQUIRE(g.find_path(v[0], v[3]).size() == 2);
+		REQUIRE_THROWS_AS(g.find_path(v[0], v[2]), plexum::exception);
+
+		g.drop_components();
+		REQUIRE(g.find_path(v[0], v[3]).size() == 2);
+	}
+}
+
+TEST_CASE("path cache", "[Graph]")
+{
+	plexum::Graph<int, int, plexum::slot_storage> g;
+	std::vector<plexum::Graph<int, int, plexum::slot_storage>::vertex_proxy::iterator> v;
+	auto all = [](int*) { return true; };
+
+	for (int i = 0; i < 5; i++)
+		v.push_back(g.vertices.add(i));
+
+	// a path 0-1-2-3 and a detour 0-4-3
+	auto e01 = g.edges.add(v[0], v[1], 1);
+	g.edges.add(v[1], v[2], 1);
+	g.edges.add(v[2], v[3], 1);
+	auto e04 = g.edges.add(v[0], v[4], 1);
+	g.edges.add(v[4], v[3], 1);
+
+	g.enable_path_cache(8);
+
+	SECTION("mutations increment the version")
+	{
+		std::size_t version = g.version();
+
+		auto w = g.vertices.add(5);
+		REQUIRE(g.version() > version);
+
+		version = g.version();
+		g.vertices.remove(w);
+		REQUIRE(g.version() > version);
+
+		version = g.version();
+		g.find_path(v[0], v[3]);
+		REQUIRE(g.version() == version);
+	}
+
+	SECTION("repeated queries are answered from the cache")
+	{
+		auto p = g.find_path(v[0], v[3], all, plexum::path_tag(0));
+		auto q = g.find_path(v[0], v[3], all, plexum::path_tag(0));
+
+		REQUIRE(p.size() == 2);
+		REQUIRE(q.size() == 2);
+		REQUIRE(q[0].id() == p[0].id());
+		REQUIRE(q[1].id() == p[1].id());
+
+		g.find_path(v[0], v[3], all, plexum::path_tag(0));
+
+		REQUIRE(g.path_cache_statistics().hits == 2);
+		REQUIRE(g.path_cache_statistics().misses == 1);
+
+		// a different tag is a different query
+		g.find_path(v[0], v[3], [&](int*) { return true; }, plexum::path_tag(1));
+
+		REQUIRE(g.path_cache_statistics().misses == 2);
+	}
+
+	SECTION("adding an edge invalidates cached paths")
+	{
+		REQUIRE(g.find_path(v[0], v[2], all, plexum::path_tag(0)).size() == 2);
+
+		g.edges.add(v[0], v[2], 1);
+
+		REQUIRE(g.find_path(v[0], v[2], all, plexum::path_tag(0)).size() == 1);
+		REQUIRE(g.path_cache_statistics().invalidations == 1);
+		REQUIRE(g.path_cache_statistics().hits == 0);
+	}
+
+	SECTION("removing an edge only invalidates the paths over it")
+	{
+		g.find_path(v[0], v[2], all, plexum::path_tag(0));
+		g.find_path(v[4], v[3], all, plexum::path_tag(0));
+
+		g.edges.remove(e01);
+
+		REQUIRE(g.find_path(v[4], v[3], all, plexum::path_tag(0)).size() == 1);
+		REQUIRE(g.path_cache_statistics().hits == 1);
+
+		REQUIRE(g.find_path(v[0], v[2], all, plexum::path_tag(0)).size() == 3);
+		REQUIRE(g.path_cache_statistics().invalidations == 1);
+
+		g.vertices.remove_with_edges(v[4]);
+
+		REQUIRE_THROWS_AS(g.find_path(v[0], v[2], all, plexum::path_tag(0)), plexum::exception);
+		REQUIRE(g.path_cache_statistics().invalidations == 2);
+	}
+
+	SECTION("the least recently used paths are evicted")
+	{
+		g.enable_path_cache(1);
+
+		g.find_path(v[0], v[3], all, plexum::path_tag(0));
+		g.find_path(v[0], v[2], all, plexum::path_tag(0));
+		g.find_path(v[0], v[3], all, plexum::path_tag(0));
+
+		REQUIRE(g.path_cache_statistics().misses == 3);
+		REQUIRE(g.path_cache_statistics().evictions == 2);
+
+		g.enable_path_cache(0);
+		g.find_path(v[0], v[3], all, plexum::path_tag(0));
+
+		REQUIRE(g.path_cache_statistics().hits == 0);
+		REQUIRE(g.path_cache_statistics().misses == 4);
+	}
+
+	SECTION("cleared caches compute paths again")
+	{
+		g.find_path(v[0], v[3], all, plexum::path_tag(0));
+		g.clear_path_cache();
+		g.edges.remove(e04);
+
+		REQUIRE(g.find_path(v[0], v[3], all, plexum::path_tag(0)).size() == 3);
+		REQUIRE(g.path_cache_statistics().misses == 2);
+	}
 }
 
 TEST_CASE("bfs", "[Graph]")
@@ -460,4 +1299,648 @@ TEST_CASE("bfs", "[Graph]")
 		std::vector<plexum::Graph<V, E>::edge_proxy::iterator> path;
 		REQUIRE_THROWS(path = g.find_path(v1, v3, [](E* e) { return e->weight >= 10; }));
 	}
+
+	SECTION("finds paths on a caller-provided workspace across graph modifications")
+	{
+		plexum::Graph<V, E>::search_workspace ws;
+		auto any = [](E*) { return true; };
+
+		REQUIRE(g.find_path(v1, v1, any, ws).empty());
+		REQUIRE(g.find_path(v1, v3, any, ws).size() == 1);
+		REQUIRE_THROWS(g.find_path(v1, v4, any, ws));
+
+		auto v5 = g.vertices.add(5);
+		auto e4 = g.edges.add(v3, v5, {3, 1});
+		auto e5 = g.edges.add(v5, v4, {4, 1});
+		g.edges.remove(e3);
+
+		std::vector<plexum::Graph<V, E>::edge_proxy::iterator> path;
+		REQUIRE_NOTHROW(path = g.find_path(v1, v4, any, ws));
+		REQUIRE(path.size() == 4);
+		REQUIRE(path[0] == e1);
+		REQUIRE(path[1] == e2);
+		REQUIRE(path[2] == e4);
+		REQUIRE(path[3] == e5);
+	}
+}
+
+TEST_CASE("lazy traversals", "[Graph]")
+{
+	plexum::Graph<V, E> g;
+	std::vector<plexum::Graph<V, E>::vertex_proxy::iterator> v;
+
+	// a binary tree of 15 vertices, a chord between the two subtrees and an isolated vertex
+	for (unsigned long i = 0; i < 16; i++)
+		v.push_back(g.vertices.add(i));
+
+	for (unsigned long i = 1; i < 15; i++)
+		g.edges.add(v[(i - 1) / 2], v[i], {i, 1});
+
+	auto chord = g.edges.add(v[3], v[14], {15, 5});
+
+	SECTION("breadth-first traversals visit vertices by increasing depth")
+	{
+		std::vector<unsigned long> order;
+		std::vector<std::size_t> depth;
+
+		auto t = g.bfs_range(v[0]);
+
+		for (auto i = t.begin(); i != t.end(); ++i) {
+			order.push_back((*i)->i);
+			depth.push_back(i.depth());
+		}
+
+		REQUIRE(order.size() == 15);
+		REQUIRE(order[0] == 0);
+		REQUIRE(std::is_sorted(depth.begin(), depth.end()));
+		REQUIRE(depth.back() == 3);
+	}
+
+	SECTION("depth-first traversals visit vertices in preorder and report parent edges")
+	{
+		auto t = g.dfs_range(v[0], [](E* e) { return e->weight < 5; });
+		std::vector<unsigned long> order;
+
+		for (auto i = t.begin(); i != t.end(); ++i) {
+			order.push_back((*i)->i);
+
+			if (i.depth() == 0) {
+				REQUIRE(i.parent_edge() == g.edges.end());
+			} else {
+				REQUIRE(i.parent_edge()->i == (*i)->i);
+				REQUIRE(i.parent_edge() != chord);
+			}
+		}
+
+		REQUIRE(order == std::vector<unsigned long>({0, 1, 3, 7, 8, 4, 9, 10, 2, 5, 11, 12, 6, 13, 14}));
+	}
+
+	SECTION("traversals stop early without exploring the rest of the graph")
+	{
+		plexum::Graph<V, E>::search_workspace ws;
+		auto t = g.bfs_range(v[0], [](E*) { return true; }, ws);
+		std::size_t seen = 0;
+
+		for (auto u : t) {
+			if (u == v[2])
+				break;
+			seen++;
+		}
+
+		REQUIRE(seen == 2);
+		REQUIRE(ws.expanded() == 2);
+		auto isolated = g.dfs_range(v[15]);
+		auto i = isolated.begin();
+		REQUIRE(*i == v[15]);
+		REQUIRE(++i == isolated.end());
+	}
+}
+
+TEST_CASE("weighted shortest paths", "[Graph]")
+{
+	plexum::Graph<V, E> g;
+
+	auto v1 = g.vertices.add(1);
+	auto v2 = g.vertices.add(2);
+	auto v3 = g.vertices.add(3);
+	auto v4 = g.vertices.add(4);
+	auto v5 = g.vertices.add(5);
+	auto e1 = g.edges.add(v1, v2, {1, 1.0});
+	auto e2 = g.edges.add(v2, v4, {2, 5.0});
+	auto e3 = g.edges.add(v1, v3, {3, 2.0});
+	auto e4 = g.edges.add(v3, v4, {4, 2.5});
+	auto e5 = g.edges.add(v2, v3, {5, 0.5});
+
+	auto weight = [](E* e) { return e->weight; };
+
+	SECTION("finds the path with the least total weight")
+	{
+		auto path = g.shortest_path(v1, v4, weight);
+
+		REQUIRE(path.size() == 3);
+		REQUIRE(path[0] == e1);
+		REQUIRE(path[1] == e5);
+		REQUIRE(path[2] == e4);
+	}
+
+	SECTION("finds the least weight path among the permitted edges")
+	{
+		auto path = g.shortest_path(v1, v4, weight, [](E* e) { return e->i != 5; });
+
+		REQUIRE(path.size() == 2);
+		REQUIRE(path[0] == e3);
+		REQUIRE(path[1] == e4);
+
+		path = g.shortest_path(v1, v4, weight, [](E* e) { return e->i != 4; });
+
+		REQUIRE(path.size() == 2);
+		REQUIRE(path[0] == e1);
+		REQUIRE(path[1] == e2);
+	}
+
+	SECTION("throws an exception if there is no path")
+	{
+		REQUIRE_THROWS(g.shortest_path(v1, v5, weight));
+		REQUIRE_THROWS(g.shortest_path(v1, v4, weight, [](E* e) { return e->i % 2 == 1; }));
+	}
+
+	SECTION("throws an exception on negative edge weights")
+	{
+		REQUIRE_THROWS(g.shortest_path(v1, v4, [](E* e) { return e->i == 3 ? -1.0 : 1.0; }));
+	}
+
+	SECTION("repeated searches on a workspace return the same paths")
+	{
+		plexum::Graph<V, E>::search_workspace ws;
+		auto any = [](E*) { return true; };
+
+		REQUIRE(g.shortest_path(v1, v1, weight, any, ws).empty());
+		REQUIRE(g.shortest_path(v1, v4, weight, any, ws).size() == 3);
+		REQUIRE_THROWS(g.shortest_path(v1, v5, weight, any, ws));
+		REQUIRE(g.shortest_path(v4, v1, weight, any, ws).size() == 3);
+		REQUIRE(g.find_path(v4, v1, any, ws).size() == 2);
+	}
+}
+
+TEST_CASE("bidirectional and goal-directed searches", "[Graph]")
+{
+	typedef plexum::Graph<V, E> graph;
+
+	graph g;
+	std::vector<graph::vertex_proxy::iterator> v;
+
+	for (unsigned long i = 0; i < 200; i++)
+		v.push_back(g.vertices.add(i));
+
+	// a ring with random chords and a second, unreachable component of 10 vertices
+	for (unsigned long i = 0; i < 190; i++)
+		g.edges.add(v[i], v[(i + 1) % 190], {1000 + 2 * i, 20.0});
+
+	for (unsigned long i = 0; i < 400; i++) {
+		unsigned long a = (i * 7919) % 190, b = (i * 104729 + 13) % 190;
+		g.edges.add(v[a], v[b], {i, 1.0 + (i * 31) % 17});
+	}
+
+	for (unsigned long i = 190; i < 199; i++)
+		g.edges.add(v[i], v[i + 1], {400 + i, 1.0});
+
+	auto weight = [](E* e) { return e->weight; };
+	auto any = [](E*) { return true; };
+	auto even = [](E* e) { return e->i % 2 == 0; };
+
+	auto length = [&](std::vector<graph::edge_proxy::iterator>& path) {
+		double sum = 0;
+		for (auto& e : path)
+			sum += e->weight;
+		return sum;
+	};
+
+	auto connects = [&](std::vector<graph::edge_proxy::iterator>& path,
+						graph::vertex_proxy::iterator s, graph::vertex_proxy::iterator t) {
+		auto c = s;
+		for (auto& e : path) {
+			if (e.from() == c)
+				c = e.to();
+			else if (e.to() == c)
+				c = e.from();
+			else
+				return false;
+		}
+		return c == t;
+	};
+
+	SECTION("bidirectional breadth-first search finds paths with the least number of edges")
+	{
+		bool match = true;
+
+		for (unsigned long i = 0; i < 190; i += 7) {
+			for (unsigned long j = 0; j < 190; j += 11) {
+				auto p = g.find_path(v[i], v[j], any, plexum::bidirectional_search());
+				auto q = g.find_path(v[i], v[j], any);
+				match &= p.size() == q.size() && connects(p, v[i], v[j]);
+			}
+		}
+
+		REQUIRE(match);
+		REQUIRE(g.find_path(v[3], v[3], any, plexum::bidirectional_search()).empty());
+		REQUIRE_THROWS(g.find_path(v[0], v[195], any, plexum::bidirectional_search()));
+	}
+
+	SECTION("bidirectional Dijkstra finds paths with the least total weight")
+	{
+		bool match = true;
+
+		for (unsigned long i = 0; i < 190; i += 7) {
+			for (unsigned long j = 0; j < 190; j += 11) {
+				auto p = g.shortest_path(v[i], v[j], weight, even, plexum::bidirectional_search());
+				auto q = g.shortest_path(v[i], v[j], weight, even);
+				match &= length(p) == length(q) && connects(p, v[i], v[j]);
+			}
+		}
+
+		REQUIRE(match);
+		REQUIRE_THROWS(g.shortest_path(v[0], v[195], weight, any, plexum::bidirectional_search()));
+	}
+
+	SECTION("A* with landmarks finds paths with the least total weight")
+	{
+		auto lm = g.landmarks(4, weight);
+		graph::search_workspace ws, ws_astar;
+		bool match = true, fewer = true;
+
+		REQUIRE(lm.count() == 4);
+		REQUIRE(lm.ids().size() == 4);
+
+		for (unsigned long i = 0; i < 190; i += 7) {
+			for (unsigned long j = 0; j < 190; j += 11) {
+				auto p = g.shortest_path(v[i], v[j], weight, any, lm, ws_astar);
+				auto q = g.shortest_path(v[i], v[j], weight, any, ws);
+				match &= length(p) == length(q) && connects(p, v[i], v[j]);
+				fewer &= ws_astar.expanded() <= ws.expanded();
+			}
+		}
+
+		REQUIRE(match);
+		REQUIRE(fewer);
+		REQUIRE_THROWS(g.shortest_path(v[0], v[195], weight, any, lm));
+	}
+
+	SECTION("landmark bounds remain valid after edges are removed")
+	{
+		auto lm = g.landmarks(3, weight);
+		g.edges.remove(g.edges[0]);
+		g.edges.remove(g.edges[1]);
+
+		auto p = g.shortest_path(v[0], v[100], weight, any, lm);
+		auto q = g.shortest_path(v[0], v[100], weight);
+
+		REQUIRE(length(p) == length(q));
+	}
+}
+
+TEST_CASE("k shortest loopless paths", "[Graph]")
+{
+	typedef plexum::Graph<V, E> graph;
+
+	graph g;
+	std::vector<graph::vertex_proxy::iterator> v;
+
+	for (unsigned long i = 0; i < 8; i++)
+		v.push_back(g.vertices.add(i));
+
+	unsigned long edges[][3] = {
+		{0, 1, 3}, {0, 2, 2}, {1, 3, 4}, {2, 1, 1}, {2, 3, 2}, {2, 4, 3},
+		{3, 4, 2}, {3, 5, 1}, {4, 5, 2}, {5, 6, 1}, {1, 6, 9}, {4, 6, 5}
+	};
+
+	for (auto& e : edges)
+		g.edges.add(v[e[0]], v[e[1]], {e[0] * 10 + e[1], static_cast<double>(e[2])});
+
+	g.edges.add(v[0], v[1], {99, 4.0});
+
+	auto weight = [](E* e) { return e->weight; };
+	auto any = [](E*) { return true; };
+
+	// weights of all simple paths from 0 to 6, by exhaustive depth-first search
+	std::vector<double> expected;
+	std::vector<bool> on_path(8, false);
+	std::function<void(unsigned long, double)> dfs = [&](unsigned long c, double w) {
+		if (c == 6) {
+			expected.push_back(w);
+			return;
+		}
+		on_path[c] = true;
+		for (auto e : v[c].edges()) {
+			unsigned long n = e.from() == v[c] ? e.to().id() : e.from().id();
+			if (!on_path[n])
+				dfs(n, w + e->weight);
+		}
+		on_path[c] = false;
+	};
+
+	dfs(0, 0);
+	std::sort(expected.begin(), expected.end());
+
+	SECTION("paths are enumerated by increasing weight")
+	{
+		std::vector<double> found;
+		std::set<std::vector<std::size_t>> distinct;
+		auto paths = g.k_shortest_paths(v[0], v[6], 100, weight, any);
+
+		for (auto& path : paths) {
+			double w = 0;
+			std::vector<std::size_t> ids;
+			std::set<std::size_t> visited = { 0 };
+			std::size_t c = 0;
+
+			for (auto e : path) {
+				w += e->weight;
+				ids.push_back(e.id());
+				c = e.from().id() == c ? e.to().id() : e.from().id();
+				REQUIRE(visited.insert(c).second);
+			}
+
+			REQUIRE(c == 6);
+			REQUIRE(w == paths.weight());
+			distinct.insert(ids);
+			found.push_back(w);
+		}
+
+		REQUIRE(found == expected);
+		REQUIRE(distinct.size() == expected.size());
+	}
+
+	SECTION("enumeration stops after k paths")
+	{
+		auto paths = g.k_shortest_paths(v[0], v[6], 3, weight, any);
+		std::size_t n = 0;
+
+		for (auto i = paths.begin(); i != paths.end(); ++i)
+			n++;
+
+		REQUIRE(n == 3);
+		REQUIRE(!paths.next());
+	}
+
+	SECTION("paths can be requested one at a time")
+	{
+		auto paths = g.k_shortest_paths(v[0], v[6], 10, weight, any);
+
+		REQUIRE(paths.next());
+		REQUIRE(paths.weight() == expected[0]);
+		REQUIRE(paths.next());
+		REQUIRE(paths.weight() == expected[1]);
+		REQUIRE(paths.path().size() > 0);
+	}
+
+	SECTION("only permitted edges are used")
+	{
+		auto paths = g.k_shortest_paths(v[0], v[6], 100, weight, [](E* e) { return e->i != 35; });
+		bool permitted = true;
+		std::size_t n = 0;
+
+		for (auto& path : paths) {
+			for (auto e : path)
+				permitted &= e->i != 35;
+			n++;
+		}
+
+		REQUIRE(permitted);
+		REQUIRE(n > 0);
+		REQUIRE(n < expected.size());
+	}
+
+	SECTION("there are no paths to an unreachable vertex")
+	{
+		auto paths = g.k_shortest_paths(v[0], v[7], 5, weight, any);
+
+		REQUIRE(paths.begin() == paths.end());
+	}
+}
+
+TEST_CASE("directed graphs", "[Graph]")
+{
+	typedef plexum::Graph<V, E, plexum::map_storage, plexum::directed> digraph;
+	typedef plexum::Graph<V, E, plexum::slot_storage, plexum::bidirectional> bigraph;
+
+	auto weight = [](E* e) { return e->weight; };
+	auto any = [](E*) { return true; };
+
+	SECTION("edges are only followed from their source to their target")
+	{
+		digraph g;
+		std::vector<digraph::vertex_proxy::iterator> v;
+
+		for (unsigned long i = 0; i < 5; i++)
+			v.push_back(g.vertices.add(i));
+
+		auto e01 = g.edges.add(v[0], v[1], {1, 1.0});
+		g.edges.add(v[1], v[2], {2, 1.0});
+		g.edges.add(v[2], v[2], {3, 1.0});
+		g.edges.add(v[3], v[2], {4, 1.0});
+		g.edges.add(v[0], v[4], {5, 1.0});
+
+		REQUIRE(v[0].degree() == 2);
+		REQUIRE(v[0].in_degree() == 0);
+		REQUIRE(v[2].degree() == 1);
+		REQUIRE(v[2].in_degree() == 3);
+		REQUIRE(g.edges.between(v[0], v[1]) == e01);
+		REQUIRE_THROWS(g.edges.between(v[1], v[0]));
+		REQUIRE(g.find_path(v[0], v[2]).size() == 2);
+		REQUIRE_THROWS(g.find_path(v[2], v[0]));
+		REQUIRE(v[4].has_neighbors());
+		REQUIRE_THROWS(g.vertices.remove(v[4]));
+
+		g.vertices.remove_with_edges(v[4]);
+		REQUIRE(v[0].degree() == 1);
+
+		g.vertices.remove_with_edges(v[2]);
+		REQUIRE(g.edges.count() == 1);
+		REQUIRE(v[1].degree() == 0);
+		REQUIRE(v[3].degree() == 0);
+		REQUIRE(directed_adjacency_consistent(g));
+	}
+
+	SECTION("incoming edges are stored separately by bidirectional graphs")
+	{
+		bigraph g;
+		std::vector<bigraph::vertex_proxy::iterator> v;
+
+		for (unsigned long i = 0; i < 4; i++)
+			v.push_back(g.vertices.add(i));
+
+		g.edges.add(v[0], v[3], {1, 1.0});
+		g.edges.add(v[1], v[3], {2, 1.0});
+		g.edges.add(v[3], v[2], {3, 1.0});
+		g.edges.add(v[3], v[3], {4, 1.0});
+
+		std::set<std::size_t> sources;
+		auto in = v[3].in_neighbor_view();
+
+		for (auto n = in.begin(); n != in.end(); ++n)
+			sources.insert(n.id());
+
+		REQUIRE(v[3].degree() == 2);
+		REQUIRE(v[3].in_degree() == 3);
+		REQUIRE(sources == std::set<std::size_t>({v[0].id(), v[1].id(), v[3].id()}));
+		REQUIRE(g.edges.between(v[1], v[3])->i == 2);
+		REQUIRE_THROWS(g.edges.between(v[3], v[1]));
+		REQUIRE_THROWS(g.find_path(v[2], v[0], any, plexum::bidirectional_search()));
+
+		g.vertices.remove_with_edges(v[3]);
+		REQUIRE(g.edges.count() == 0);
+		REQUIRE(v[0].degree() == 0);
+		REQUIRE(v[2].in_degree() == 0);
+	}
+
+	SECTION("adjacency stays consistent under bulk loads and removals")
+	{
+		digraph d;
+		bigraph b;
+		std::vector<unsigned long> values;
+		std::vector<std::tuple<std::size_t, std::size_t, E>> links;
+		std::minstd_rand rng(5);
+
+		for (unsigned long i = 0; i < 80; i++)
+			values.push_back(i);
+
+		auto dv = d.vertices.add_range(values.begin(), values.end());
+		auto bv = b.vertices.add_range(values.begin(), values.end());
+
+		for (unsigned long i = 0; i < 600; i++)
+			links.push_back(std::make_tuple(rng() % 80, rng() % 80, E(i, 1.0)));
+
+		for (auto& l : links) {
+			d.edges.add(d.vertices[dv[std::get<0>(l)]], d.vertices[dv[std::get<1>(l)]], std::get<2>(l));
+			std::get<0>(l) = bv[std::get<0>(l)];
+			std::get<1>(l) = bv[std::get<1>(l)];
+		}
+
+		b.edges.add_range(links.begin(), links.end(), 2);
+
+		REQUIRE(directed_adjacency_consistent(d));
+		REQUIRE(directed_adjacency_consistent(b));
+
+		for (unsigned long i = 0; i < 100; i++) {
+			d.edges.remove(d.edges.begin());
+			b.edges.remove(b.edges.begin());
+		}
+
+		d.vertices.remove_with_edges(d.vertices[dv[7]]);
+		b.vertices.remove_with_edges(b.vertices[bv[7]]);
+		d.vertices.remove_with_edges({d.vertices[dv[1]], d.vertices[dv[2]], d.vertices[dv[40]]});
+		b.vertices.remove_with_edges({b.vertices[bv[1]], b.vertices[bv[2]], b.vertices[bv[40]]});
+
+		REQUIRE(d.edges.count() == b.edges.count());
+		REQUIRE(directed_adjacency_consistent(d));
+		REQUIRE(directed_adjacency_consistent(b));
+
+		bool in_lists = true;
+		std::size_t in_entries = 0;
+
+		for (auto i = b.vertices.begin(); i != b.vertices.end(); ++i) {
+			auto r = i.in_edge_view();
+
+			for (auto e = r.begin(); e != r.end(); ++e, in_entries++)
+				in_lists &= e.edge().to() == i;
+		}
+
+		REQUIRE(in_lists);
+		REQUIRE(in_entries == b.edges.count());
+
+		for (unsigned long i = 0; i < 80; i += 3) {
+			for (unsigned long j = 0; j < 80; j += 7) {
+				if (i == 1 || i == 2 || i == 7 || i == 40 || j == 1 || j == 2 || j == 7 || j == 40)
+					continue;
+
+				bool reached = true;
+				std::size_t hops = 0;
+
+				try {
+					hops = d.find_path(d.vertices[dv[i]], d.vertices[dv[j]]).size();
+				} catch (plexum::exception&) {
+					reached = false;
+				}
+
+				if (reached) {
+					auto p = b.find_path(b.vertices[bv[i]], b.vertices[bv[j]], any,
+										 plexum::bidirectional_search());
+					REQUIRE(p.size() == hops);
+				} else {
+					REQUIRE_THROWS(b.find_path(b.vertices[bv[i]], b.vertices[bv[j]], any,
+											   plexum::bidirectional_search()));
+				}
+			}
+		}
+	}
+
+	SECTION("shortest path searches respect edge directions")
+	{
+		bigraph g;
+		std::vector<bigraph::vertex_proxy::iterator> v;
+		std::minstd_rand rng(11);
+
+		for (unsigned long i = 0; i < 120; i++)
+			v.push_back(g.vertices.add(i));
+
+		for (unsigned long i = 0; i < 120; i++)
+			g.edges.add(v[i], v[(i + 1) % 120], {i, 10.0});
+
+		for (unsigned long i = 0; i < 300; i++)
+			g.edges.add(v[rng() % 120], v[rng() % 120], {1000 + i, 1.0 + rng() % 9});
+
+		auto lm = g.landmarks(4, weight);
+		auto follows = [&](std::vector<bigraph::edge_proxy::iterator>& path,
+						   bigraph::vertex_proxy::iterator s, bigraph::vertex_proxy::iterator t) {
+			for (auto& e : path) {
+				if (e.from() != s)
+					return false;
+				s = e.to();
+			}
+			return s == t;
+		};
+		auto length = [](std::vector<bigraph::edge_proxy::iterator>& path) {
+			double sum = 0;
+			for (auto& e : path)
+				sum += e->weight;
+			return sum;
+		};
+
+		bool match = true;
+
+		for (unsigned long i = 0; i < 120; i += 13) {
+			for (unsigned long j = 0; j < 120; j += 17) {
+				auto p = g.shortest_path(v[i], v[j], weight);
+				auto q = g.shortest_path(v[i], v[j], weight, any, plexum::bidirectional_search());
+				auto r = g.shortest_path(v[i], v[j], weight, any, lm);
+				match &= follows(p, v[i], v[j]) && follows(q, v[i], v[j]) && follows(r, v[i], v[j]);
+				match &= length(p) == length(q) && length(p) == length(r);
+			}
+		}
+
+		REQUIRE(match);
+
+		auto paths = g.k_shortest_paths(v[5], v[90], 10, weight, any);
+		double last = 0;
+		std::size_t count = 0;
+
+		for (auto p : paths) {
+			REQUIRE(follows(p, v[5], v[90]));
+			REQUIRE(length(p) >= last);
+			last = length(p);
+			count++;
+		}
+
+		REQUIRE(count == 10);
+	}
+
+	SECTION("snapshots of directed graphs hold the out-adjacency")
+	{
+		digraph g;
+		std::vector<digraph::vertex_proxy::iterator> v;
+		std::minstd_rand rng(2);
+
+		for (unsigned long i = 0; i < 3000; i++)
+			v.push_back(g.vertices.add(i));
+
+		for (unsigned long i = 0; i < 30000; i++)
+			g.edges.add(v[rng() % 3000], v[rng() % 3000], {i, 1.0});
+
+		auto c = g.freeze();
+		auto tree = c.bfs(0, 2);
+		bool match = true;
+
+		REQUIRE(c.directed());
+		REQUIRE(c.adjacency().size() == g.edges.count());
+
+		for (unsigned long i = 0; i < 3000; i += 37) {
+			try {
+				match &= tree.level[i] == g.find_path(v[0], v[i]).size();
+			} catch (plexum::exception&) {
+				match &= tree.level[i] == c.npos;
+			}
+		}
+
+		REQUIRE(match);
+	}
 }
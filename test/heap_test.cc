@@ -0,0 +1,62 @@
+#include <catch.h>
+
+#include <plexum/heap.h>
+
+TEST_CASE("indexed heap", "[indexed_heap]")
+{
+	plexum::indexed_heap<double> h;
+	h.reset(10);
+
+	SECTION("items are popped in key order")
+	{
+		h.push(3, 3.0);
+		h.push(1, 1.0);
+		h.push(7, 7.0);
+		h.push(5, 0.5);
+		h.push(2, 2.0);
+
+		REQUIRE(h.size() == 5);
+		REQUIRE(h.top() == 5);
+		REQUIRE(h.pop() == 5);
+		REQUIRE(h.pop() == 1);
+		REQUIRE(h.pop() == 2);
+		REQUIRE(h.pop() == 3);
+		REQUIRE(h.pop() == 7);
+		REQUIRE(h.empty());
+	}
+
+	SECTION("keys of queued items can be decreased")
+	{
+		h.push(0, 5.0);
+		h.push(1, 6.0);
+		h.push(2, 7.0);
+
+		REQUIRE(h.push_or_decrease(2, 1.0));
+		REQUIRE(!h.push_or_decrease(0, 9.0));
+		REQUIRE(h.push_or_decrease(4, 5.5));
+
+		REQUIRE(h.pop() == 2);
+		REQUIRE(h.pop() == 0);
+		REQUIRE(h.top_key() == 5.5);
+		REQUIRE(h.pop() == 4);
+		REQUIRE(h.pop() == 1);
+	}
+
+	SECTION("cleared heaps can be reused")
+	{
+		h.push(0, 1.0);
+		h.push(1, 2.0);
+		h.pop();
+		h.reset(20);
+
+		REQUIRE(h.empty());
+		REQUIRE(!h.contains(0));
+		REQUIRE(!h.contains(1));
+
+		for (std::size_t i = 0; i < 20; i++)
+			h.push(19 - i, static_cast<double>(19 - i));
+
+		for (std::size_t i = 0; i < 20; i++)
+			REQUIRE(h.pop() == i);
+	}
+}
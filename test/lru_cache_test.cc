@@ -0,0 +1,84 @@
+#include <catch.h>
+
+#include <string>
+
+#include <plexum/lru_cache.h>
+
+TEST_CASE("lru cache", "[lru_cache]")
+{
+	plexum::lru_cache<int, std::string> c(2);
+
+	SECTION("stored values are found")
+	{
+		REQUIRE(c.find(1) == nullptr);
+		REQUIRE(!c.insert(1, "one"));
+		REQUIRE(!c.insert(2, "two"));
+
+		REQUIRE(*c.find(1) == "one");
+		REQUIRE(*c.find(2) == "two");
+		REQUIRE(c.size() == 2);
+
+		REQUIRE(!c.insert(1, "uno"));
+		REQUIRE(*c.find(1) == "uno");
+		REQUIRE(c.size() == 2);
+	}
+
+	SECTION("the least recently used entry is evicted")
+	{
+		c.insert(1, "one");
+		c.insert(2, "two");
+		c.find(1);
+
+		REQUIRE(c.insert(3, "three"));
+		REQUIRE(c.find(2) == nullptr);
+		REQUIRE(*c.find(1) == "one");
+		REQUIRE(*c.find(3) == "three");
+
+		c.set_capacity(1);
+
+		REQUIRE(c.size() == 1);
+		REQUIRE(c.find(1) == nullptr);
+		REQUIRE(c.find(3) != nullptr);
+	}
+
+	SECTION("entries can be erased")
+	{
+		c.insert(1, "one");
+		c.insert(2, "two");
+		c.erase(1);
+		c.erase(5);
+
+		REQUIRE(c.find(1) == nullptr);
+		REQUIRE(c.size() == 1);
+
+		c.clear();
+
+		REQUIRE(c.size() == 0);
+		REQUIRE(c.find(2) == nullptr);
+	}
+
+	SECTION("a capacity of 0 disables the cache")
+	{
+		c.set_capacity(0);
+
+		REQUIRE(!c.insert(1, "one"));
+		REQUIRE(c.find(1) == nullptr);
+		REQUIRE(c.size() == 0);
+	}
+
+	SECTION("copies are independent")
+	{
+		c.insert(1, "one");
+		plexum::lru_cache<int, std::string> d(c);
+		d.insert(2, "two");
+		d.insert(3, "three");
+
+		REQUIRE(d.find(1) == nullptr);
+		REQUIRE(*c.find(1) == "one");
+
+		c = d;
+
+		REQUIRE(*c.find(3) == "three");
+		REQUIRE(c.find(1) == nullptr);
+	}
+}
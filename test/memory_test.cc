@@ -0,0 +1,190 @@
+#include <catch.h>
+
+#include <cstdint>
+#include <new>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <plexum/graph.h>
+
+// counts the bytes passed through to the global heap
+class counting_resource : public plexum::memory_resource
+{
+public:
+	counting_resource() : outstanding(0), allocations(0) { }
+	std::size_t outstanding;
+	std::size_t allocations;
+
+protected:
+	void* do_allocate(std::size_t bytes, std::size_t alignment)
+	{
+		outstanding += bytes;
+		allocations++;
+		return plexum::new_delete_resource()->allocate(bytes, alignment);
+	}
+
+	void do_deallocate(void* p, std::size_t bytes, std::size_t alignment)
+	{
+		outstanding -= bytes;
+		plexum::new_delete_resource()->deallocate(p, bytes, alignment);
+	}
+};
+
+// fails every allocation once *budget* allocations have been served
+class failing_resource : public counting_resource
+{
+public:
+	failing_resource() : budget(static_cast<std::size_t>(-1)) { }
+	std::size_t budget;
+
+protected:
+	void* do_allocate(std::size_t bytes, std::size_t alignment)
+	{
+		if (budget == 0)
+			throw std::bad_alloc();
+
+		budget--;
+		return counting_resource::do_allocate(bytes, alignment);
+	}
+};
+
+TEST_CASE("monotonic arena", "[memory]")
+{
+	counting_resource upstream;
+	plexum::monotonic_arena arena(1024, &upstream);
+
+	SECTION("allocations are aligned and served from growing blocks")
+	{
+		void* a = arena.allocate(3, 1);
+		void* b = arena.allocate(8, 8);
+		void* c = arena.allocate(4000, 16);
+
+		REQUIRE(reinterpret_cast<std::uintptr_t>(b) % 8 == 0);
+		REQUIRE(reinterpret_cast<std::uintptr_t>(c) % 16 == 0);
+		REQUIRE(static_cast<char*>(b) >= static_cast<char*>(a) + 3);
+		REQUIRE(arena.allocated() == 4011);
+		REQUIRE(upstream.allocations == 2);
+
+		arena.deallocate(c, 4000, 16);
+		arena.release();
+
+		REQUIRE(upstream.outstanding == 0);
+		REQUIRE(arena.allocated() == 0);
+	}
+
+	SECTION("reset reuses the blocks without going upstream")
+	{
+		for (int i = 0; i < 100; i++)
+			arena.allocate(100);
+
+		std::size_t blocks = upstream.allocations;
+		arena.reset();
+
+		for (int i = 0; i < 100; i++)
+			arena.allocate(100);
+
+		REQUIRE(upstream.allocations == blocks);
+	}
+}
+
+TEST_CASE("graphs on a memory resource", "[memory]")
+{
+	counting_resource upstream;
+
+	SECTION("all storage of a graph comes from its resource")
+	{
+		{
+			plexum::Graph<std::string, int, plexum::slot_storage> g(&upstream);
+			auto a = g.vertices.add("a");
+			auto b = g.vertices.add("b");
+			auto e = g.edges.add(a, b, 1);
+			g.edges.add(b, a, 2);
+
+			REQUIRE(g.resource() == &upstream);
+			REQUIRE(upstream.outstanding > 0);
+			REQUIRE(g.find_path(a, b).size() == 1);
+
+			g.edges.remove(e);
+			g.vertices.remove_with_edges(a);
+		}
+
+		REQUIRE(upstream.outstanding == 0);
+	}
+
+	SECTION("bulk edge insertion leaves the graph unchanged if an allocation fails")
+	{
+		failing_resource r;
+		bool added = false;
+
+		for (std::size_t k = 0; !added; k++) {
+			{
+				plexum::Graph<int, int> g(&r);
+				std::vector<std::size_t> v;
+
+				for (int i = 0; i < 6; i++)
+					v.push_back(g.vertices.add(i).id());
+
+				g.edges.add(g.vertices[v[0]], g.vertices[v[1]], 0);
+
+				std::vector<std::tuple<std::size_t, std::size_t, int>> links;
+				links.push_back(std::make_tuple(v[0], v[2], 1));
+				links.push_back(std::make_tuple(v[1], v[2], 2));
+				links.push_back(std::make_tuple(v[2], v[2], 3));
+
+				r.budget = k;
+
+				try {
+					g.edges.add_range(links.begin(), links.end());
+					added = true;
+				} catch (std::bad_alloc&) { }
+
+				r.budget = static_cast<std::size_t>(-1);
+
+				std::size_t degrees = 0;
+
+				for (auto i = g.vertices.begin(); i != g.vertices.end(); ++i)
+					degrees += i.degree();
+
+				REQUIRE(g.edges.count() == (added ? 4 : 1));
+				REQUIRE(degrees == 2 * g.edges.count());
+				if (added)
+					REQUIRE(g.find_path(g.vertices[v[1]], g.vertices[v[2]]).size() == 1);
+				else
+					REQUIRE_THROWS_AS(g.find_path(g.vertices[v[1]], g.vertices[v[2]]),
+									  plexum::exception);
+			}
+
+			REQUIRE(r.outstanding == 0);
+		}
+	}
+
+	SECTION("graphs on an arena behave like graphs on the heap")
+	{
+		plexum::monotonic_arena arena(4096, &upstream);
+
+		for (int round = 0; round < 3; round++) {
+			{
+				plexum::Graph<int, int> g(&arena);
+				std::vector<plexum::Graph<int, int>::vertex_proxy::iterator> v;
+
+				for (int i = 0; i < 200; i++)
+					v.push_back(g.vertices.add(i));
+
+				for (int i = 1; i < 200; i++)
+					g.edges.add(v[i - 1], v[i], i);
+
+				REQUIRE(g.find_path(v[0], v[199]).size() == 199);
+				REQUIRE(arena.allocated() > 0);
+			}
+
+			arena.reset();
+		}
+
+		std::size_t blocks = upstream.allocations;
+		arena.release();
+
+		REQUIRE(upstream.outstanding == 0);
+		REQUIRE(blocks < 10);
+	}
+}
@@ -0,0 +1,205 @@
+#include <catch.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+#include <plexum/csr.h>
+#include <plexum/edge_list.h>
+#include <plexum/graph.h>
+
+TEST_CASE("output buffer", "[output_buffer]")
+{
+	std::ostringstream os;
+
+	SECTION("numbers are formatted like the stream would")
+	{
+		{
+			plexum::output_buffer out(os);
+			out << 0 << ' ' << -42 << ' ' << 18446744073709551615ull << ' ' << -9223372036854775807ll - 1
+				<< ' ' << 0.1 << ' ' << 2.5f << ' ' << 1e300 << ' ' << std::string("s") << 'c';
+		}
+
+		REQUIRE(os.str() == "0 -42 18446744073709551615 -9223372036854775808 0.1 2.5 1e+300 sc");
+	}
+
+	SECTION("character types are formatted like the stream would")
+	{
+		std::ostringstream expected;
+		signed char s = 'x';
+		unsigned char u = 'y';
+		expected << s << u << L'w';
+
+		{
+			plexum::output_buffer out(os);
+			out << s << u << L'w';
+		}
+
+		REQUIRE(os.str() == expected.str());
+		REQUIRE(os.str().substr(0, 2) == "xy");
+	}
+
+	SECTION("text reaches the stream once the capacity is exceeded or on flush")
+	{
+		plexum::output_buffer out(os, 8);
+
+		out << "1234";
+		out.commit();
+		REQUIRE(os.str().empty());
+
+		out << "5678";
+		out.commit();
+		REQUIRE(os.str() == "12345678");
+
+		out << "9";
+		out.flush();
+		REQUIRE(os.str() == "123456789");
+	}
+
+	SECTION("appended text can be escaped")
+	{
+		{
+			plexum::output_buffer out(os);
+			out << "\"";
+			std::size_t from = out.size();
+			out << "a\"b\\c\n";
+			out.escape(from, plexum::output_buffer::dot_string);
+			out << "\" ";
+			from = out.size();
+			out << "<x & 'y'>";
+			out.escape(from, plexum::output_buffer::xml_text);
+			from = out.size();
+			out << " plain";
+			out.escape(from, plexum::output_buffer::xml_text);
+		}
+
+		REQUIRE(os.str() == "\"a\\\"b\\\\c\\n\" &lt;x &amp; 'y'&gt; plain");
+	}
+}
+
+TEST_CASE("graph exporters", "[Graph]")
+{
+	plexum::Graph<std::string, int> g;
+
+	auto a = g.vertices.add("a");
+	auto b = g.vertices.add("b \"quoted\"");
+	auto c = g.vertices.add("<c>");
+	g.edges.add(a, b, 1);
+	g.edges.add(b, c, 2);
+	g.edges.add(a, c, 3);
+
+	SECTION("the graph is printed with comma separated neighbors")
+	{
+		std::ostringstream os;
+		os << g;
+
+		REQUIRE(os.str() == "Graph(n=3, m=3)\n a -> [ b \"quoted\", <c> ]\n"
+				" b \"quoted\" -> [ a, <c> ]\n <c> -> [ b \"quoted\", a ]\n");
+	}
+
+	SECTION("printed values follow the precision and flags of the stream")
+	{
+		plexum::Graph<double, int> h;
+		auto pi = h.vertices.add(3.14159265358979);
+		h.edges.add(pi, h.vertices.add(0.5), 1);
+
+		std::ostringstream gs, cs;
+		gs << h;
+		cs << h.freeze();
+
+		REQUIRE(gs.str() == "Graph(n=2, m=1)\n 3.14159 -> [ 0.5 ]\n 0.5 -> [ 3.14159 ]\n");
+		REQUIRE(cs.str() == gs.str());
+
+		gs.str(std::string());
+		cs.str(std::string());
+		gs << std::fixed << std::setprecision(2) << h;
+		cs << std::fixed << std::setprecision(2) << h.freeze();
+
+		REQUIRE(gs.str() == "Graph(n=2, m=1)\n 3.14 -> [ 0.50 ]\n 0.50 -> [ 3.14 ]\n");
+		REQUIRE(cs.str() == gs.str());
+	}
+
+	SECTION("DOT output names vertices by id and escapes labels")
+	{
+		std::ostringstream os;
+		g.write_dot(os);
+
+		REQUIRE(os.str() == "graph {\n"
+				"  0 [label=\"a\"];\n"
+				"  1 [label=\"b \\\"quoted\\\"\"];\n"
+				"  2 [label=\"<c>\"];\n"
+				"  0 -- 1 [label=\"1\"];\n"
+				"  1 -- 2 [label=\"2\"];\n"
+				"  0 -- 2 [label=\"3\"];\n"
+				"}\n");
+
+		plexum::Graph<int, int, plexum::map_storage, plexum::directed> d;
+		auto x = d.vertices.add(1);
+		auto y = d.vertices.add(2);
+		d.edges.add(x, y, 3);
+		os.str("");
+		d.write_dot(os, [](plexum::output_buffer& out, int v) { out << "v" << v; });
+
+		REQUIRE(os.str() == "digraph {\n  0 [label=\"v1\"];\n  1 [label=\"v2\"];\n"
+				"  0 -> 1 [label=\"3\"];\n}\n");
+	}
+
+	SECTION("GraphML output escapes markup")
+	{
+		std::ostringstream os;
+		g.write_graphml(os);
+		std::string s = os.str();
+
+		REQUIRE(s.find("<graph id=\"G\" edgedefault=\"undirected\">") != std::string::npos);
+		REQUIRE(s.find("<node id=\"n1\"><data key=\"v\">b &quot;quoted&quot;</data></node>")
+				!= std::string::npos);
+		REQUIRE(s.find("<node id=\"n2\"><data key=\"v\">&lt;c&gt;</data></node>") != std::string::npos);
+		REQUIRE(s.find("<edge id=\"e2\" source=\"n0\" target=\"n2\"><data key=\"e\">3</data></edge>")
+				!= std::string::npos);
+		REQUIRE(s.substr(s.size() - 22) == "  </graph>\n</graphml>\n");
+	}
+
+	SECTION("edge lists can be read back")
+	{
+		std::ostringstream os;
+		g.write_edge_list(os);
+
+		REQUIRE(os.str() == "0 1 1\n1 2 2\n0 2 3\n");
+
+		os.str("");
+		g.write_edge_list(os, [](plexum::output_buffer&, int) { });
+
+		REQUIRE(os.str() == "0 1\n1 2\n0 2\n");
+
+		const char* path = "output_test_edges.txt";
+		{
+			std::ofstream out(path);
+			g.write_edge_list(out);
+		}
+
+		plexum::Graph<std::size_t, int> h;
+		auto ids = plexum::read_edge_list(h, path);
+		std::remove(path);
+
+		REQUIRE(h.edges.count() == 3);
+		REQUIRE(*h.edges.between(h.vertices[ids[0]], h.vertices[ids[2]]) == 3);
+	}
+
+	SECTION("binary output opens as a snapshot")
+	{
+		plexum::Graph<int, int> h;
+		auto x = h.vertices.add(1);
+		auto y = h.vertices.add(2);
+		h.edges.add(x, y, 3);
+
+		const char* path = "output_test_graph.bin";
+		h.write_binary(path);
+		auto s = plexum::csr_graph<int, int>::open(path);
+		std::remove(path);
+
+		REQUIRE(s.vertex_count() == 2);
+		REQUIRE(s.edge(0) == 3);
+	}
+}
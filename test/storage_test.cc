@@ -0,0 +1,155 @@
+#include <catch.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include <plexum/graph.h>
+
+TEST_CASE("slot storage", "[slot_storage]")
+{
+	plexum::Graph<int, int, plexum::slot_storage> g;
+
+	auto a = g.vertices.add(1);
+	auto b = g.vertices.add(2);
+	auto c = g.vertices.add(3);
+	auto d = g.edges.add(a, b, 1);
+	auto e = g.edges.add(b, c, 2);
+
+	SECTION("elements receive sequential ids on an empty graph")
+	{
+		REQUIRE(a.id() == 0);
+		REQUIRE(b.id() == 1);
+		REQUIRE(c.id() == 2);
+		REQUIRE(d.id() == 0);
+		REQUIRE(e.id() == 1);
+
+		REQUIRE(g.vertices.count() == 3);
+		REQUIRE(g.edges.count() == 2);
+		REQUIRE(*g.vertices[1] == 2);
+		REQUIRE(*g.edges[1] == 2);
+	}
+
+	SECTION("ids remain stable when other elements are removed")
+	{
+		g.edges.remove(d);
+		g.vertices.remove(a);
+
+		REQUIRE(!g.vertices.has_index(0));
+		REQUIRE(g.vertices[1] == b);
+		REQUIRE(g.vertices[2] == c);
+		REQUIRE(g.edges[1] == e);
+		REQUIRE(g.edges.between(c, b) == e);
+
+		auto i = g.vertices.begin();
+		REQUIRE(i.id() == 1);
+		i++;
+		REQUIRE(i.id() == 2);
+		i++;
+		REQUIRE(i == g.vertices.end());
+	}
+
+	SECTION("freed slots are recycled under a new id")
+	{
+		g.edges.remove(d);
+		g.vertices.remove(a);
+
+		auto f = g.vertices.add(4);
+
+		REQUIRE(f.id() != 0);
+		REQUIRE(plexum::slot_storage<int>::index(f.id()) == 0);
+		REQUIRE(!g.vertices.has_index(0));
+		REQUIRE_THROWS(g.vertices[0]);
+		REQUIRE(*g.vertices[f.id()] == 4);
+		REQUIRE(g.vertices.count() == 3);
+		REQUIRE(g.vertices.begin() == f);
+	}
+
+	SECTION("element addresses remain stable while the storage grows")
+	{
+		int* p = &(*a);
+
+		for (int i = 0; i < 5000; i++)
+			g.vertices.add(i);
+
+		REQUIRE(&(*g.vertices[0]) == p);
+		REQUIRE(g.vertices.count() == 5003);
+		REQUIRE(g.edges.between(a, b) == d);
+	}
+
+	SECTION("paths can be found")
+	{
+		auto path = g.find_path(a, c);
+
+		REQUIRE(path.size() == 2);
+		REQUIRE(path[0] == d);
+		REQUIRE(path[1] == e);
+	}
+}
+
+namespace
+{
+	struct checked
+	{
+		checked(std::size_t id, int value)
+			: id(id),
+			  value(value)
+		{
+			if (value < 0)
+				throw std::runtime_error("negative value");
+		}
+
+		std::size_t id;
+		int value;
+	};
+}
+
+TEST_CASE("bulk construction", "[slot_storage]")
+{
+	SECTION("free slots are reused before fresh ones")
+	{
+		plexum::Graph<int, int, plexum::slot_storage> g;
+
+		auto a = g.vertices.add(1);
+		g.vertices.add(2);
+		std::size_t old = a.id();
+		g.vertices.remove(a);
+
+		std::vector<int> values(200000, 7);
+		values[0] = 3;
+		auto ids = g.vertices.add_range(values.begin(), values.end(), 4);
+
+		REQUIRE(ids.size() == values.size());
+		REQUIRE(plexum::slot_storage<int>::index(ids[0]) == 0);
+		REQUIRE(ids[0] != old);
+		REQUIRE(plexum::slot_storage<int>::index(ids[1]) == 2);
+		REQUIRE(*g.vertices[ids[0]] == 3);
+		REQUIRE(*g.vertices[ids.back()] == 7);
+		REQUIRE(g.vertices.count() == values.size() + 1);
+	}
+
+	SECTION("a failed construction leaves the storage unchanged")
+	{
+		plexum::slot_storage<checked> s;
+		s.emplace(1);
+		s.erase(s.emplace(2));
+
+		const std::size_t n = 200000;
+		auto value = [](std::size_t i) { return i == n / 2 ? -1 : static_cast<int>(i); };
+		auto ignore = [](std::size_t, plexum::slot_storage<checked>::value_type&) { };
+
+		REQUIRE_THROWS_AS(s.emplace_range(n, 4, value, ignore), std::runtime_error);
+		REQUIRE(s.size() == 1);
+		REQUIRE(s.bound() == 2);
+		REQUIRE(std::distance(s.begin(), s.end()) == 1);
+
+		std::vector<int> seen(n, 0);
+		s.emplace_range(n, 4, [](std::size_t i) { return static_cast<int>(i); },
+			[&seen](std::size_t i, plexum::slot_storage<checked>::value_type& p) {
+				seen[i] = p.second.value == static_cast<int>(i) && p.first == p.second.id;
+			});
+
+		REQUIRE(s.size() == n + 1);
+		REQUIRE(std::count(seen.begin(), seen.end(), 1) == static_cast<std::ptrdiff_t>(n));
+	}
+}
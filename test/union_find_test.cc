@@ -0,0 +1,45 @@
+#include <catch.h>
+
+#include <plexum/union_find.h>
+
+TEST_CASE("union find", "[union_find]")
+{
+	plexum::union_find u;
+
+	SECTION("untouched indices are sets of their own")
+	{
+		REQUIRE(u.find(5) == 5);
+		REQUIRE(u.root(1000) == 1000);
+		REQUIRE(u.set_size(3) == 1);
+	}
+
+	SECTION("united sets share a representative")
+	{
+		REQUIRE(u.unite(0, 1));
+		REQUIRE(u.unite(2, 3));
+		REQUIRE(u.unite(1, 3));
+		REQUIRE(!u.unite(0, 2));
+		REQUIRE(u.unite(10, 11));
+
+		REQUIRE(u.find(0) == u.find(3));
+		REQUIRE(u.root(2) == u.find(1));
+		REQUIRE(u.find(0) != u.find(10));
+		REQUIRE(u.find(4) == 4);
+		REQUIRE(u.set_size(2) == 4);
+		REQUIRE(u.set_size(11) == 2);
+
+		u.clear();
+
+		REQUIRE(u.find(3) == 3);
+		REQUIRE(u.set_size(0) == 1);
+	}
+
+	SECTION("long chains of unions form a single set")
+	{
+		for (std::size_t i = 1; i < 100000; i++)
+			u.unite(i - 1, i);
+
+		REQUIRE(u.root(99999) == u.root(0));
+		REQUIRE(u.set_size(50000) == 100000);
+	}
+}